@@ -251,6 +251,42 @@ CharSet* CharSet::createInstance(MemoryPool& pool, USHORT id, charset* cs)
 }
 
 
+bool CharSet::checkAsciiCompatible() const
+{
+	if (minBytesPerChar() != 1)
+		return false;
+
+	UCHAR ascii[0x7F];
+	USHORT unicode[0x7F];
+	UCHAR back[0x7F];
+
+	for (unsigned i = 0; i < sizeof(ascii); ++i)
+		ascii[i] = i + 1;
+
+	try
+	{
+		if (getConvToUnicode().convert(sizeof(ascii), ascii, sizeof(unicode), unicode) != sizeof(unicode) ||
+			getConvFromUnicode().convert(sizeof(unicode), unicode, sizeof(back), back) != sizeof(back) ||
+			memcmp(ascii, back, sizeof(ascii)) != 0)
+		{
+			return false;
+		}
+	}
+	catch (const Exception&)
+	{
+		return false;
+	}
+
+	for (unsigned i = 0; i < sizeof(ascii); ++i)
+	{
+		if (unicode[i] != ascii[i])
+			return false;
+	}
+
+	return true;
+}
+
+
 ULONG CharSet::removeTrailingSpaces(ULONG srcLen, const UCHAR* src) const
 {
 	const unsigned spaceLen = getSpaceLength();
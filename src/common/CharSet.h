@@ -76,6 +76,8 @@ protected:
 			memset(sqlMatchOne, 0, sizeof(sqlMatchOne));
 			sqlMatchOneLength = 0;
 		}
+
+		asciiCompatible = checkAsciiCompatible();
 	}
 
 private:
@@ -93,6 +95,9 @@ public:
 	USHORT getFlags() const { return cs->charset_flags; }
 	bool shouldCheckWellFormedness() const { return cs->charset_fn_well_formed != NULL; }
 
+	// 7-bit characters are single bytes of the same value
+	bool isAsciiCompatible() const { return asciiCompatible; }
+
 	bool isMultiByte() const
 	{
 		return cs->charset_min_bytes_per_char != cs->charset_max_bytes_per_char;
@@ -133,12 +138,15 @@ public:
 							const ULONG startPos, const ULONG length) const = 0;
 
 private:
+	bool checkAsciiCompatible() const;
+
 	USHORT id;
 	charset* cs;
 	UCHAR sqlMatchAny[sizeof(ULONG)];
 	UCHAR sqlMatchOne[sizeof(ULONG)];
 	BYTE sqlMatchAnyLength;
 	BYTE sqlMatchOneLength;
+	bool asciiCompatible;
 };
 
 }	// namespace Firebird
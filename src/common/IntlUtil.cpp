@@ -32,6 +32,7 @@
 #include "../intl/country_codes.h"
 #include "../common/classes/auto.h"
 #include "../common/classes/Aligner.h"
+#include "../common/StringSearch.h"
 #include <unicode/utf8.h>
 
 
@@ -594,9 +595,32 @@ void IntlUtil::finiCharset(charset* cs)
 }
 
 
+// Check if case of the string may be changed without conversion to Unicode
+static bool asciiCaseChange(Firebird::CharSet* cs, ULONG srcLen, const UCHAR* src, ULONG dstLen,
+	const ULONG* exceptions)
+{
+	if (!cs->isAsciiCompatible() || dstLen < srcLen)
+		return false;
+
+	for (const ULONG* p = exceptions; p && *p; ++p)
+	{
+		if (*p < 0x80)
+			return false;
+	}
+
+	return StringSearch::isAscii(src, srcLen);
+}
+
+
 ULONG IntlUtil::toLower(Firebird::CharSet* cs, ULONG srcLen, const UCHAR* src, ULONG dstLen, UCHAR* dst,
 	const ULONG* exceptions)
 {
+	if (asciiCaseChange(cs, srcLen, src, dstLen, exceptions))
+	{
+		StringSearch::asciiToLower(src, srcLen, dst);
+		return srcLen;
+	}
+
 	const ULONG utf16_length = cs->getConvToUnicode().convertLength(srcLen);
 	Firebird::HalfStaticArray<UCHAR, BUFFER_SMALL> utf16_str;
 	UCHAR* utf16_ptr;
@@ -623,6 +647,12 @@ ULONG IntlUtil::toLower(Firebird::CharSet* cs, ULONG srcLen, const UCHAR* src, U
 ULONG IntlUtil::toUpper(Firebird::CharSet* cs, ULONG srcLen, const UCHAR* src, ULONG dstLen, UCHAR* dst,
 	const ULONG* exceptions)
 {
+	if (asciiCaseChange(cs, srcLen, src, dstLen, exceptions))
+	{
+		StringSearch::asciiToUpper(src, srcLen, dst);
+		return srcLen;
+	}
+
 	const ULONG utf16_length = cs->getConvToUnicode().convertLength(srcLen);
 	Firebird::HalfStaticArray<UCHAR, BUFFER_SMALL> utf16_str;
 	UCHAR* utf16_ptr;
@@ -774,9 +774,25 @@ namespace
 namespace Firebird {
 
 
+void SimilarToMatchRange::init(const RE2& regexp)
+{
+	std::string min, max;
+
+	valid = regexp.PossibleMatchRange(&min, &max, MAX_LENGTH);
+
+	if (valid)
+	{
+		minMatch.assign(min.data(), min.length());
+		maxMatch.assign(max.data(), max.length());
+	}
+}
+
+//---------------------
+
 SimilarToRegex::SimilarToRegex(MemoryPool& pool, unsigned flags,
 		const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen)
-	: PermanentStorage(pool)
+	: PermanentStorage(pool),
+	  range(pool)
 {
 	SimilarToCompiler compiler(pool, regexp,
 		COMP_FLAG_GROUP_CAPTURE | COMP_FLAG_PREFER_FEWER |
@@ -785,6 +801,7 @@ SimilarToRegex::SimilarToRegex(MemoryPool& pool, unsigned flags,
 			((flags & SimilarToFlag::WELLFORMED) ? COMP_FLAG_WELLFORMED : 0),
 		patternStr, patternLen, escapeStr, escapeLen);
 
+	range.init(*regexp);
 	finalizer = pool.registerFinalizer(finalize, this);
 }
 
@@ -800,6 +817,9 @@ void SimilarToRegex::finalize(SimilarToRegex* self)
 
 bool SimilarToRegex::matches(const char* buffer, unsigned bufferLen, Array<MatchPos>* matchPosArray)
 {
+	if (!range.mayMatch(buffer, bufferLen))
+		return false;
+
 	re2::StringPiece sp(buffer, bufferLen);
 
 	if (matchPosArray)
@@ -849,7 +869,8 @@ bool SimilarToRegex::matches(const char* buffer, unsigned bufferLen, Array<Match
 
 SubstringSimilarRegex::SubstringSimilarRegex(MemoryPool& pool, unsigned flags,
 		const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen)
-	: PermanentStorage(pool)
+	: PermanentStorage(pool),
+	  range(pool)
 {
 	SubstringSimilarCompiler compiler(pool, regexp,
 		((flags & SimilarToFlag::CASE_INSENSITIVE) ? COMP_FLAG_CASE_INSENSITIVE : 0) |
@@ -857,6 +878,7 @@ SubstringSimilarRegex::SubstringSimilarRegex(MemoryPool& pool, unsigned flags,
 			((flags & SimilarToFlag::WELLFORMED) ? COMP_FLAG_WELLFORMED : 0),
 		patternStr, patternLen, escapeStr, escapeLen);
 
+	range.init(*regexp);
 	finalizer = pool.registerFinalizer(finalize, this);
 }
 
@@ -873,6 +895,9 @@ void SubstringSimilarRegex::finalize(SubstringSimilarRegex* self)
 bool SubstringSimilarRegex::matches(const char* buffer, unsigned bufferLen,
 	unsigned* resultStart, unsigned* resultLength)
 {
+	if (!range.mayMatch(buffer, bufferLen))
+		return false;
+
 	re2::StringPiece sp(buffer, bufferLen);
 
 	re2::StringPiece spResult;
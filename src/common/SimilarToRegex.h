@@ -37,6 +37,41 @@ namespace SimilarToFlag
 	static const unsigned WELLFORMED = 0x4;
 };
 
+// Range of the strings a program may match as a whole, allows to reject
+// the data with a couple of comparisons instead of running the program.
+class SimilarToMatchRange
+{
+	static const int MAX_LENGTH = 32;
+
+public:
+	explicit SimilarToMatchRange(MemoryPool& pool)
+		: minMatch(pool), maxMatch(pool), valid(false)
+	{ }
+
+	void init(const re2::RE2& regexp);
+
+	bool mayMatch(const char* buffer, unsigned bufferLen) const
+	{
+		return !valid ||
+			(compare(buffer, bufferLen, minMatch) >= 0 && compare(buffer, bufferLen, maxMatch) <= 0);
+	}
+
+private:
+	static int compare(const char* buffer, unsigned bufferLen, const string& bound)
+	{
+		const unsigned length = MIN(bufferLen, bound.length());
+		const int result = length ? memcmp(buffer, bound.c_str(), length) : 0;
+
+		if (result)
+			return result;
+
+		return bufferLen < bound.length() ? -1 : (bufferLen > bound.length() ? 1 : 0);
+	}
+
+	string minMatch, maxMatch;
+	bool valid;
+};
+
 class SimilarToRegex : public PermanentStorage
 {
 public:
@@ -85,6 +120,7 @@ public:
 private:
 	MemoryPool::Finalizer* finalizer = nullptr;
 	AutoPtr<re2::RE2> regexp;
+	SimilarToMatchRange range;
 };
 
 // Given a regular expression R1<escape>#R2#<escape>R3 and the string S:
@@ -107,6 +143,7 @@ public:
 private:
 	MemoryPool::Finalizer* finalizer = nullptr;
 	AutoPtr<re2::RE2> regexp;
+	SimilarToMatchRange range;
 };
 
 
@@ -0,0 +1,195 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef COMMON_STRING_SEARCH_H
+#define COMMON_STRING_SEARCH_H
+
+#include <string.h>
+
+// SSE2 is a part of the base instruction set on x64
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FB_STRING_SEARCH_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace Firebird {
+namespace StringSearch {
+
+#ifdef FB_STRING_SEARCH_SSE2
+const unsigned SSE_BLOCK = 16;
+
+inline unsigned lowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Returns the first position of ch in [data, end) or end if there is none
+template <typename CharType>
+inline const CharType* findChar(const CharType* data, const CharType* end, CharType ch)
+{
+	if (sizeof(CharType) == 1)
+	{
+		const void* const p = data < end ? memchr(data, (UCHAR) ch, end - data) : NULL;
+		return p ? static_cast<const CharType*>(p) : end;
+	}
+
+	while (data < end && *data != ch)
+		++data;
+
+	return data;
+}
+
+// Returns the first occurrence of the pattern in data or NULL if there is none.
+// Candidates are filtered by the first and the last characters of the pattern,
+// sixteen positions at a time for the byte strings.
+template <typename CharType>
+inline const CharType* find(const CharType* data, SLONG dataLen, const CharType* pattern, SLONG patternLen)
+{
+	if (patternLen <= 0)
+		return data;
+
+	if (dataLen < patternLen)
+		return NULL;
+
+	const CharType first = pattern[0];
+	const CharType last = pattern[patternLen - 1];
+	const SLONG middle = (patternLen - 2) * sizeof(CharType);
+
+	// Possible starts of the occurrence
+	const CharType* p = data;
+	const CharType* const limit = data + dataLen - patternLen + 1;
+
+	if (patternLen == 1)
+	{
+		p = findChar(p, limit, first);
+		return p < limit ? p : NULL;
+	}
+
+#ifdef FB_STRING_SEARCH_SSE2
+	if (sizeof(CharType) == 1)
+	{
+		const __m128i firstMask = _mm_set1_epi8((char) first);
+		const __m128i lastMask = _mm_set1_epi8((char) last);
+
+		for (; limit - p >= (SLONG) SSE_BLOCK; p += SSE_BLOCK)
+		{
+			const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + patternLen - 1));
+
+			unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+				_mm_cmpeq_epi8(blockFirst, firstMask), _mm_cmpeq_epi8(blockLast, lastMask)));
+
+			while (mask)
+			{
+				const CharType* const candidate = p + lowestBit(mask);
+
+				if (memcmp(candidate + 1, pattern + 1, middle) == 0)
+					return candidate;
+
+				mask &= mask - 1;
+			}
+		}
+	}
+#endif
+
+	while ((p = findChar(p, limit, first)) < limit)
+	{
+		if (p[patternLen - 1] == last && memcmp(p + 1, pattern + 1, middle) == 0)
+			return p;
+
+		++p;
+	}
+
+	return NULL;
+}
+
+// Checks whether all the bytes are 7-bit characters
+inline bool isAscii(const UCHAR* data, ULONG length)
+{
+	const UCHAR* const end = data + length;
+
+#ifdef FB_STRING_SEARCH_SSE2
+	__m128i acc = _mm_setzero_si128();
+
+	for (; end - data >= (SLONG) SSE_BLOCK; data += SSE_BLOCK)
+		acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+
+	if (_mm_movemask_epi8(acc))
+		return false;
+#endif
+
+	UCHAR bits = 0;
+
+	while (data < end)
+		bits |= *data++;
+
+	return !(bits & 0x80);
+}
+
+// Changes case of the 7-bit characters from [from, to] range
+inline void asciiChangeCase(const UCHAR* src, ULONG length, UCHAR* dst, UCHAR from, UCHAR to)
+{
+	const UCHAR* const end = src + length;
+
+#ifdef FB_STRING_SEARCH_SSE2
+	const __m128i lowBound = _mm_set1_epi8((char) (from - 1));
+	const __m128i highBound = _mm_set1_epi8((char) (to + 1));
+	const __m128i caseBit = _mm_set1_epi8(0x20);
+
+	for (; end - src >= (SLONG) SSE_BLOCK; src += SSE_BLOCK, dst += SSE_BLOCK)
+	{
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+		// Bytes above 0x7F are negative and never fall into the range
+		const __m128i inRange = _mm_and_si128(
+			_mm_cmpgt_epi8(block, lowBound), _mm_cmplt_epi8(block, highBound));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+			_mm_xor_si128(block, _mm_and_si128(inRange, caseBit)));
+	}
+#endif
+
+	for (; src < end; ++src, ++dst)
+		*dst = (*src >= from && *src <= to) ? (*src ^ 0x20) : *src;
+}
+
+inline void asciiToUpper(const UCHAR* src, ULONG length, UCHAR* dst)
+{
+	asciiChangeCase(src, length, dst, 'a', 'z');
+}
+
+inline void asciiToLower(const UCHAR* src, ULONG length, UCHAR* dst)
+{
+	asciiChangeCase(src, length, dst, 'A', 'Z');
+}
+
+} // namespace StringSearch
+} // namespace Firebird
+
+#endif // COMMON_STRING_SEARCH_H
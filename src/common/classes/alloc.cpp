@@ -1586,6 +1586,101 @@ private:
 };
 
 
+#undef POOL_THREAD_CACHE
+#if !defined(DELAYED_FREE) && !defined(VALIDATE_POOL) && !defined(TLS_CLASS)
+#define POOL_THREAD_CACHE
+#endif
+
+#ifdef POOL_THREAD_CACHE
+
+// Caches of free small and medium blocks placed in front of the pool free lists.
+// Threads are spread over a few stripes, each guarded by its own mutex, so threads
+// sharing a pool do not serialize on the pool mutex. Blocks move between a stripe
+// and the pool in batches. Cache is created when the pool mutex is found contended,
+// pools used by a single thread never get it.
+
+// Stripe number (1-based, 0 - not assigned yet) of the current thread
+TLS_DECLARE(unsigned, threadStripe);
+static AtomicCounter stripeCounter;
+
+class MemThreadCache
+{
+public:
+	static const unsigned STRIPES = 8;
+	static const unsigned SLOT_BYTES = 4096;		// memory kept per small slot
+	static const unsigned MAX_DEPTH = 64;			// blocks kept per small slot
+	static const unsigned MEDIUM_SLOTS = 11;		// medium blocks up to 4224 bytes are cached
+	static const unsigned MEDIUM_DEPTH = 2;			// blocks kept per medium slot
+
+	class Slot
+	{
+	public:
+		MemBlock* get()
+		{
+			MemBlock* block = list;
+			if (block)
+			{
+				list = block->next;
+				--count;
+			}
+			return block;
+		}
+
+		void put(MemBlock* block)
+		{
+			block->next = list;
+			list = block;
+			++count;
+		}
+
+		MemBlock* list;
+		unsigned count;
+	};
+
+	class Stripe
+	{
+	public:
+		Stripe()
+		{
+			memset(small, 0, sizeof(small));
+			memset(medium, 0, sizeof(medium));
+		}
+
+		Mutex mutex;
+		Slot small[LowLimits::TOTAL_ELEMENTS];
+		Slot medium[MEDIUM_SLOTS];
+	};
+
+	static unsigned getDepth(unsigned slot)
+	{
+		const unsigned depth = SLOT_BYTES / LowLimits::getSize(slot);
+		return depth < 4 ? 4 : depth > MAX_DEPTH ? MAX_DEPTH : depth;
+	}
+
+	static unsigned getMediumLimit()
+	{
+		return MediumLimits::getSize(MEDIUM_SLOTS - 1);
+	}
+
+	Stripe& getStripe()
+	{
+		unsigned n = TLS_GET(threadStripe);
+		if (!n)
+		{
+			n = unsigned(stripeCounter.exchangeAdd(1) % STRIPES) + 1;
+			TLS_SET(threadStripe, n);
+		}
+
+		return stripes[n - 1];
+	}
+
+private:
+	Stripe stripes[STRIPES];
+};
+
+#endif // POOL_THREAD_CACHE
+
+
 // Implementation of memory pool
 
 class MemPool
@@ -1677,6 +1772,15 @@ private:
 	MemBlock* allocateInternal(size_t from, size_t& length, bool flagRedirect);
 	void releaseBlock(MemBlock *block, bool flagDecr) noexcept;
 
+#ifdef POOL_THREAD_CACHE
+	std::atomic<MemThreadCache*> threadCache;
+	std::atomic<bool> threadCacheRequested;
+
+	void createThreadCache();
+	MemBlock* allocateCached(MemThreadCache* cache, size_t& length);
+	bool releaseCached(MemThreadCache* cache, MemBlock* block) noexcept;
+#endif
+
 public:
 	void* allocate(size_t size ALLOC_PARAMS);
 	MemBlock* allocateRange(size_t from, size_t& size ALLOC_PARAMS);
@@ -1980,6 +2084,11 @@ void MemPool::initialize()
 	blocksAllocated = 0;
 	blocksActive = 0;
 
+#ifdef POOL_THREAD_CACHE
+	threadCache = nullptr;
+	threadCacheRequested = false;
+#endif
+
 #ifdef DELAYED_FREE
 	delayedFreeCount = 0;
 	delayedFreePos = 0;
@@ -2008,6 +2117,11 @@ MemPool::~MemPool(void)
 {
 	pool_destroying = true;
 
+#ifdef POOL_THREAD_CACHE
+	// Cached blocks are released together with the extents they live in
+	delete threadCache.exchange(nullptr);
+#endif
+
 	decrement_usage(used_memory.value());
 	decrement_mapping(mapped_memory.value());
 
@@ -2151,8 +2265,32 @@ void MemoryPool::setStatsGroup(MemoryStats& newStats) noexcept
 
 MemBlock* MemPool::allocateInternal(size_t from, size_t& length, bool flagRedirect)
 {
+#ifdef POOL_THREAD_CACHE
+	if (!from)
+	{
+		MemThreadCache* const cache = threadCache.load(std::memory_order_acquire);
+		if (cache)
+		{
+			MemBlock* const block = allocateCached(cache, length);
+			if (block)
+				return block;
+		}
+	}
+#endif
+
 	MutexEnsureUnlock guard(mutex, "MemPool::allocateInternal");
+
+#ifdef POOL_THREAD_CACHE
+	if (!guard.tryEnter())
+	{
+		if (!threadCacheRequested.load(std::memory_order_relaxed))
+			createThreadCache();
+
+		guard.enter();
+	}
+#else
 	guard.enter();
+#endif
 
 	++blocksAllocated;
 	++blocksActive;
@@ -2349,6 +2487,18 @@ void MemPool::releaseBlock(MemBlock* block, bool decrUsage) noexcept
 
 	const size_t length = block->getSize();
 
+#ifdef POOL_THREAD_CACHE
+	if (decrUsage && !block->redirected())
+	{
+		MemThreadCache* const cache = threadCache.load(std::memory_order_acquire);
+		if (cache && releaseCached(cache, block))
+		{
+			decrement_usage(length);
+			return;
+		}
+	}
+#endif
+
 	MutexEnsureUnlock guard(mutex, "MemPool::releaseBlock");
 	guard.enter();
 
@@ -2396,6 +2546,126 @@ void MemPool::releaseBlock(MemBlock* block, bool decrUsage) noexcept
 	releaseRaw(pool_destroying, hunk, hunk->length, nullptr);
 }
 
+#ifdef POOL_THREAD_CACHE
+void MemPool::createThreadCache()
+{
+	// Only the first thread which met contention creates the cache
+	if (threadCacheRequested.exchange(true))
+		return;
+
+	try
+	{
+		threadCache.store(FB_NEW MemThreadCache, std::memory_order_release);
+	}
+	catch (const Exception&)
+	{
+		// Not a problem - the pool keeps working without the cache
+	}
+}
+
+MemBlock* MemPool::allocateCached(MemThreadCache* cache, size_t& length)
+{
+	// Blocks kept in the cache are counted as active ones in the pool
+	// but not as used memory in pool statistics
+
+	const size_t fullSize = length + offsetof(MemBlock, body);
+
+	if (fullSize <= LowLimits::TOP_LIMIT)
+	{
+		const unsigned n = LowLimits::getSlot(fullSize, SLOT_ALLOC);
+		MemThreadCache::Stripe& stripe = cache->getStripe();
+
+		MutexLockGuard guard(stripe.mutex, "MemPool::allocateCached");
+		MemThreadCache::Slot& slot = stripe.small[n];
+
+		if (!slot.count)
+		{
+			// Refill the slot with a batch of blocks taken under single pool lock
+			MutexLockGuard poolGuard(mutex, "MemPool::allocateCached /pool");
+
+			for (unsigned batch = MemThreadCache::getDepth(n) / 2; batch; --batch)
+			{
+				size_t size = length;
+				slot.put(smallObjects.allocateBlock(this, 0, size));
+
+				++blocksAllocated;
+				++blocksActive;
+			}
+		}
+
+		length = LowLimits::getSize(n) - offsetof(MemBlock, body);
+		return slot.get();
+	}
+
+	if (fullSize <= MemThreadCache::getMediumLimit())
+	{
+		const unsigned n = MediumLimits::getSlot(fullSize, SLOT_ALLOC);
+		MemThreadCache::Stripe& stripe = cache->getStripe();
+
+		MutexLockGuard guard(stripe.mutex, "MemPool::allocateCached");
+		MemBlock* const block = stripe.medium[n].get();
+
+		if (block)
+			length = MediumLimits::getSize(n) - offsetof(MemBlock, body);
+
+		return block;
+	}
+
+	return NULL;
+}
+
+bool MemPool::releaseCached(MemThreadCache* cache, MemBlock* block) noexcept
+{
+	const size_t length = block->getSize();
+
+	if (length <= LowLimits::TOP_LIMIT)
+	{
+		const unsigned n = LowLimits::getSlot(length, SLOT_ALLOC);
+		MemThreadCache::Stripe& stripe = cache->getStripe();
+
+		MutexLockGuard guard(stripe.mutex, "MemPool::releaseCached");
+		MemThreadCache::Slot& slot = stripe.small[n];
+
+		const unsigned depth = MemThreadCache::getDepth(n);
+		if (slot.count >= depth)
+		{
+			// Slot is full - return a batch of blocks to the pool under single lock
+			MutexLockGuard poolGuard(mutex, "MemPool::releaseCached /pool");
+
+			for (unsigned batch = depth / 2; batch; --batch)
+			{
+				smallObjects.deallocateBlock(slot.get());
+				--blocksActive;
+			}
+		}
+
+		slot.put(block);
+		return true;
+	}
+
+	if (length <= MemThreadCache::getMediumLimit())
+	{
+		// Medium slot keeps only blocks of exactly its size
+		const unsigned n = MediumLimits::getSlot(length, SLOT_ALLOC);
+		if (MediumLimits::getSize(n) != length)
+			return false;
+
+		MemThreadCache::Stripe& stripe = cache->getStripe();
+
+		MutexLockGuard guard(stripe.mutex, "MemPool::releaseCached");
+		MemThreadCache::Slot& slot = stripe.medium[n];
+
+		if (slot.count >= MemThreadCache::MEDIUM_DEPTH)
+			return false;
+
+		slot.put(block);
+		return true;
+	}
+
+	return false;
+}
+#endif // POOL_THREAD_CACHE
+
 void MemPool::memoryIsExhausted(void)
 {
 	Firebird::BadAlloc::raise();
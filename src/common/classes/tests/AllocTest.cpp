@@ -0,0 +1,98 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/classes/alloc.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(CommonSuite)
+BOOST_AUTO_TEST_SUITE(AllocSuite)
+
+
+BOOST_AUTO_TEST_SUITE(AllocTests)
+
+static const unsigned THREADS = 8;
+static const unsigned LIVE_BLOCKS = 256;
+
+// Mix of small and medium blocks allocated and released in random order,
+// part of the blocks is released by a thread other than the allocating one
+static void stress(MemoryPool* pool, unsigned seed, unsigned iterations, void** exchange)
+{
+	void* live[LIVE_BLOCKS] = {};
+
+	for (unsigned i = 0; i < iterations; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		const unsigned n = (seed >> 8) % LIVE_BLOCKS;
+		const size_t size = (seed >> 16) % 8 ? 8 + (seed >> 20) % 512 : 1024 + (seed >> 20) % 4096;
+
+		if (live[n])
+			pool->deallocate(live[n]);
+
+		live[n] = pool->allocate(size ALLOC_ARGS);
+		memset(live[n], n, size);
+	}
+
+	for (unsigned n = 0; n < LIVE_BLOCKS; ++n)
+	{
+		if (n % 2)
+			pool->deallocate(live[n]);
+		else
+			exchange[n / 2] = live[n];
+	}
+}
+
+BOOST_AUTO_TEST_CASE(MultiThreadedStressTest)
+{
+	MemoryStats stats;
+	MemoryPool* const pool = MemoryPool::createPool(getDefaultMemoryPool(), stats);
+
+	std::vector<void*> exchange(THREADS * LIVE_BLOCKS / 2);
+	std::vector<std::thread> threads;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (unsigned t = 0; t < THREADS; ++t)
+		threads.emplace_back(stress, pool, t + 1, 200000u, &exchange[t * LIVE_BLOCKS / 2]);
+
+	for (auto& thread : threads)
+		thread.join();
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - start);
+
+	BOOST_TEST_MESSAGE("MemoryPool stress: " << THREADS << " threads, " <<
+		elapsed.count() << " ms");
+
+	BOOST_TEST(stats.getCurrentUsage() > 0u);
+
+	// Release blocks left by every thread from the thread of its neighbour
+
+	threads.clear();
+
+	for (unsigned t = 0; t < THREADS; ++t)
+	{
+		void** const blocks = &exchange[(t + 1) % THREADS * LIVE_BLOCKS / 2];
+
+		threads.emplace_back([pool, blocks]()
+		{
+			for (unsigned n = 0; n < LIVE_BLOCKS / 2; ++n)
+				pool->deallocate(blocks[n]);
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	BOOST_TEST(stats.getCurrentUsage() == 0u);
+
+	MemoryPool::deletePool(pool);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// AllocTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// AllocSuite
+BOOST_AUTO_TEST_SUITE_END()	// CommonSuite
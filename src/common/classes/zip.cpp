@@ -73,4 +73,30 @@ void ZLib::freeFunc(void*, void* address)
 	MemoryPool::globalFree(address);
 }
 
+ZStd::ZStd(Firebird::MemoryPool&)
+{
+#ifdef WIN_NT
+	Firebird::PathName name("libzstd.dll");
+#else
+	Firebird::PathName name("libzstd." SHRLIB_EXT ".1");
+#endif
+	z.reset(ModuleLoader::fixAndLoadModule(status, name));
+	if (z)
+		symbols();
+}
+
+void ZStd::symbols()
+{
+#define FB_ZSYMB(A) z->findSymbol(status, STRINGIZE(A), A); if (!A) { z.reset(NULL); return; }
+	FB_ZSYMB(ZSTD_createCCtx)
+	FB_ZSYMB(ZSTD_freeCCtx)
+	FB_ZSYMB(ZSTD_CCtx_setParameter)
+	FB_ZSYMB(ZSTD_compressStream2)
+	FB_ZSYMB(ZSTD_createDCtx)
+	FB_ZSYMB(ZSTD_freeDCtx)
+	FB_ZSYMB(ZSTD_decompressStream)
+	FB_ZSYMB(ZSTD_isError)
+#undef FB_ZSYMB
+}
+
 #endif // HAVE_ZLIB_H
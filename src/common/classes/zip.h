@@ -59,6 +59,56 @@ namespace Firebird {
 
 		void symbols();
 	};
+
+	// Zstandard library is loaded dynamically too. Its header is not
+	// required at build time - the few types and functions used here
+	// belong to the stable part of zstd API (since v1.4.0).
+
+	class ZStd
+	{
+	public:
+		explicit ZStd(Firebird::MemoryPool&);
+
+		struct CCtx;
+		struct DCtx;
+
+		struct InBuffer
+		{
+			const void* src;
+			size_t size;
+			size_t pos;
+		};
+
+		struct OutBuffer
+		{
+			void* dst;
+			size_t size;
+			size_t pos;
+		};
+
+		static constexpr int C_COMPRESSION_LEVEL = 100;	// ZSTD_c_compressionLevel
+		static constexpr int E_CONTINUE = 0;			// ZSTD_e_continue
+		static constexpr int E_FLUSH = 1;				// ZSTD_e_flush
+
+		CCtx* (*ZSTD_createCCtx)();
+		size_t (*ZSTD_freeCCtx)(CCtx* cctx);
+		size_t (*ZSTD_CCtx_setParameter)(CCtx* cctx, int param, int value);
+		size_t (*ZSTD_compressStream2)(CCtx* cctx, OutBuffer* output, InBuffer* input, int endOp);
+		DCtx* (*ZSTD_createDCtx)();
+		size_t (*ZSTD_freeDCtx)(DCtx* dctx);
+		size_t (*ZSTD_decompressStream)(DCtx* dctx, OutBuffer* output, InBuffer* input);
+		unsigned (*ZSTD_isError)(size_t code);
+
+		operator bool() { return z.hasData(); }
+		bool operator!() { return !z.hasData(); }
+
+		ISC_STATUS_ARRAY status;
+
+	private:
+		AutoPtr<ModuleLoader::Module> z;
+
+		void symbols();
+	};
 }
 #endif // HAVE_ZLIB_H
 
@@ -38,6 +38,8 @@
 #include <stdlib.h>
 #endif
 
+#include <thread>
+
 // NS 2014-07-23 FIXME: Rework error handling
 // 1. We shall not silently truncate upper bits of integer values read from configuration files.
 // 2. Invalid configuration file values that we ignored shall leave trace in firebird.log
@@ -332,6 +334,19 @@ void Config::fixDefaults()
 		pValue->intVal = pDefault->intVal;
 
 
+	pDefault = &defaults[KEY_MAX_WORKER_THREADS];
+	pValue = &values[KEY_MAX_WORKER_THREADS];
+	if (pDefault->intVal < 0)
+	{
+		// Workers mostly wait for I/O and locks, so allow several of them per CPU
+		const unsigned cpus = std::thread::hardware_concurrency();	// 0 if unknown
+		pDefault->intVal = MAX(8 * (SINT64) cpus, 64);
+	}
+
+	if (pValue->intVal < 0)
+		pValue->intVal = pDefault->intVal;
+
+
 	pDefault = &defaults[KEY_GC_POLICY];
 	pValue = &values[KEY_GC_POLICY];
 	if (!pDefault->strVal)
@@ -368,6 +383,8 @@ void Config::checkValues()
 
 	checkIntForLoBound(KEY_LOCK_MEM_SIZE, 256 * 1024, false);
 
+	checkIntForLoBound(KEY_MAX_WORKER_THREADS, 0, true);
+
 	const char* strVal = values[KEY_GC_POLICY].strVal;
 	if (strVal)
 	{
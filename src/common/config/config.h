@@ -187,6 +187,12 @@ enum ConfigKey
 	KEY_PARALLEL_WORKERS,
 	KEY_MAX_PARALLEL_WORKERS,
 	KEY_OPTIMIZE_FOR_FIRST_ROWS,
+	KEY_LOCAL_SOCKET_NAME,
+	KEY_WIRE_COMPRESSION_CODEC,
+	KEY_WIRE_COMPRESSION_LEVEL,
+	KEY_MAX_WORKER_THREADS,
+	KEY_PARAMETER_SENSITIVE_PLANS,
+	KEY_RESULT_CACHE,
 	MAX_CONFIG_KEY		// keep it last
 };
 
@@ -300,7 +306,13 @@ constexpr ConfigEntry entries[MAX_CONFIG_KEY] =
 	{TYPE_INTEGER,	"MaxStatementCacheSize",	false,	2 * 1048576},	// bytes
 	{TYPE_INTEGER,	"ParallelWorkers",			true,	1},
 	{TYPE_INTEGER,	"MaxParallelWorkers",		true,	1},
-	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false}
+	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false},
+	{TYPE_STRING,	"LocalSocketName",			false,	""},
+	{TYPE_STRING,	"WireCompressionCodec",		false,	"zlib"},
+	{TYPE_INTEGER,	"WireCompressionLevel",		false,	0},
+	{TYPE_INTEGER,	"MaxWorkerThreads",			true,	-1},		// threads, depends on CPU count
+	{TYPE_BOOLEAN,	"ParameterSensitivePlans",	false,	false},
+	{TYPE_BOOLEAN,	"ResultCache",				false,	false}
 };
 
 
@@ -624,6 +636,24 @@ public:
 	CONFIG_GET_GLOBAL_INT(getMaxParallelWorkers, KEY_MAX_PARALLEL_WORKERS);
 
 	CONFIG_GET_PER_DB_BOOL(getOptimizeForFirstRows, KEY_OPTIMIZE_FOR_FIRST_ROWS);
+
+	// Name of the Unix domain socket used by the local protocol
+	CONFIG_GET_PER_DB_STR(getLocalSocketName, KEY_LOCAL_SOCKET_NAME);
+
+	// Preferred wire compression codec
+	CONFIG_GET_PER_DB_STR(getWireCompressionCodec, KEY_WIRE_COMPRESSION_CODEC);
+
+	// Wire compression level, 0 means default level of the codec
+	CONFIG_GET_PER_DB_INT(getWireCompressionLevel, KEY_WIRE_COMPRESSION_LEVEL);
+
+	// Limit of threads serving requests of remote clients, 0 - no limit
+	CONFIG_GET_GLOBAL_INT(getMaxWorkerThreads, KEY_MAX_WORKER_THREADS);
+
+	// Choose between index and full scan at runtime depending on parameter values
+	CONFIG_GET_PER_DB_BOOL(getParameterSensitivePlans, KEY_PARAMETER_SENSITIVE_PLANS);
+
+	// Memoize correlated sub-queries and deterministic function calls
+	CONFIG_GET_PER_DB_BOOL(getResultCache, KEY_RESULT_CACHE);
 };
 
 // Implementation of interface to access master configuration file
@@ -0,0 +1,212 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/StringSearch.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(CommonSuite)
+BOOST_AUTO_TEST_SUITE(StringSearchSuite)
+
+static const UCHAR* u(const std::string& s)
+{
+	return reinterpret_cast<const UCHAR*>(s.data());
+}
+
+static SLONG find(const std::string& data, const std::string& pattern)
+{
+	const UCHAR* const p = StringSearch::find(u(data), (SLONG) data.length(), u(pattern), (SLONG) pattern.length());
+	return p ? (SLONG) (p - u(data)) : -1;
+}
+
+
+BOOST_AUTO_TEST_SUITE(StringSearchTests)
+
+BOOST_AUTO_TEST_CASE(FindTest)
+{
+	BOOST_TEST(find("", "") == 0);
+	BOOST_TEST(find("abc", "") == 0);
+	BOOST_TEST(find("", "a") == -1);
+	BOOST_TEST(find("abc", "c") == 2);
+	BOOST_TEST(find("abc", "abcd") == -1);
+	BOOST_TEST(find("abcabd", "abd") == 3);
+
+	// Every pattern position against every data length, both sides of the SIMD blocks
+	const std::string text = "the quick brown fox jumps over the lazy dog, THE QUICK BROWN FOX JUMPS";
+
+	for (size_t len = 0; len <= text.length(); ++len)
+	{
+		const std::string data = text.substr(0, len);
+
+		for (size_t start = 0; start < text.length(); ++start)
+		{
+			for (size_t patternLen = 1; patternLen <= 20 && start + patternLen <= text.length(); ++patternLen)
+			{
+				const std::string pattern = text.substr(start, patternLen);
+				const size_t expected = data.find(pattern);
+
+				BOOST_TEST(find(data, pattern) == (expected == std::string::npos ? -1 : (SLONG) expected));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(FindWideTest)
+{
+	const USHORT data[] = {1, 2, 3, 1, 2, 4, 0x102, 5};
+	const USHORT pattern[] = {1, 2, 4};
+	const USHORT missing[] = {2, 5};
+
+	BOOST_TEST(StringSearch::find(data, 8, pattern, 3) == data + 3);
+	BOOST_TEST(StringSearch::find(data, 8, missing, 2) == nullptr);
+	BOOST_TEST(StringSearch::findChar(data, data + 8, (USHORT) 0x102) == data + 6);
+	BOOST_TEST(StringSearch::findChar(data, data + 8, (USHORT) 0x02) == data + 1);
+}
+
+BOOST_AUTO_TEST_CASE(AsciiCaseTest)
+{
+	std::string text;
+
+	for (unsigned i = 0; i < 1000; ++i)
+		text += (char) (i % 256);
+
+	BOOST_TEST(!StringSearch::isAscii(u(text), (ULONG) text.length()));
+	BOOST_TEST(StringSearch::isAscii(u(text), 128));
+	BOOST_TEST(StringSearch::isAscii(u(text) + 256, 128));
+	BOOST_TEST(!StringSearch::isAscii(u(text) + 256, 129));
+
+	std::string upper(text.length(), 0), lower(text.length(), 0);
+	StringSearch::asciiToUpper(u(text), (ULONG) text.length(), (UCHAR*) &upper[0]);
+	StringSearch::asciiToLower(u(text), (ULONG) text.length(), (UCHAR*) &lower[0]);
+
+	for (size_t i = 0; i < text.length(); ++i)
+	{
+		const UCHAR c = text[i];
+		BOOST_TEST((UCHAR) upper[i] == ((c >= 'a' && c <= 'z') ? c - 0x20 : c));
+		BOOST_TEST((UCHAR) lower[i] == ((c >= 'A' && c <= 'Z') ? c + 0x20 : c));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// StringSearchTests
+
+
+BOOST_AUTO_TEST_SUITE(StringSearchBenchmarks)
+
+static const unsigned ROWS = 2000;
+static const unsigned ROW_LENGTH = 4000;
+static const unsigned DISTINCT_ROWS = 16;
+
+static std::vector<std::string> makeRows(unsigned seed)
+{
+	std::vector<std::string> rows(DISTINCT_ROWS);
+
+	for (auto& row : rows)
+	{
+		row.reserve(ROW_LENGTH);
+
+		while (row.length() < ROW_LENGTH)
+		{
+			seed = seed * 1103515245 + 12345;
+			row += (char) ('a' + (seed >> 16) % 26);
+
+			if ((seed >> 8) % 7 == 0)
+				row += ' ';
+		}
+
+		row.resize(ROW_LENGTH);
+	}
+
+	return rows;
+}
+
+template <typename F>
+static double measure(F func)
+{
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+BOOST_AUTO_TEST_CASE(ContainingBenchmark)
+{
+	const std::vector<std::string> rows = makeRows(1);
+	const std::string pattern = "firebird";
+	unsigned plainFound = 0, fastFound = 0;
+
+	// Byte by byte loop as a reference
+	const double plain = measure([&]
+	{
+		for (unsigned i = 0; i < ROWS; ++i)
+		{
+			const std::string& row = rows[i % DISTINCT_ROWS];
+
+			for (size_t pos = 0; pos + pattern.length() <= row.length(); ++pos)
+			{
+				if (memcmp(row.data() + pos, pattern.data(), pattern.length()) == 0)
+				{
+					++plainFound;
+					break;
+				}
+			}
+		}
+	});
+
+	const double fast = measure([&]
+	{
+		for (unsigned i = 0; i < ROWS; ++i)
+		{
+			if (find(rows[i % DISTINCT_ROWS], pattern) >= 0)
+				++fastFound;
+		}
+	});
+
+	BOOST_TEST(plainFound == fastFound);
+	BOOST_TEST_MESSAGE("CONTAINING over " << ROWS << " rows of " << ROW_LENGTH <<
+		" bytes: plain " << plain << " ms, StringSearch::find " << fast << " ms");
+}
+
+BOOST_AUTO_TEST_CASE(UpperBenchmark)
+{
+	const std::vector<std::string> rows = makeRows(2);
+	std::string plainUpper(ROW_LENGTH, 0), fastUpper(ROW_LENGTH, 0);
+	unsigned plainSum = 0, fastSum = 0;
+
+	const double plain = measure([&]
+	{
+		for (unsigned i = 0; i < ROWS; ++i)
+		{
+			const std::string& row = rows[i % DISTINCT_ROWS];
+
+			for (size_t pos = 0; pos < row.length(); ++pos)
+				plainUpper[pos] = (char) toupper((UCHAR) row[pos]);
+
+			plainSum += (UCHAR) plainUpper[i % ROW_LENGTH];
+		}
+	});
+
+	const double fast = measure([&]
+	{
+		for (unsigned i = 0; i < ROWS; ++i)
+		{
+			const std::string& row = rows[i % DISTINCT_ROWS];
+
+			if (StringSearch::isAscii(u(row), (ULONG) row.length()))
+				StringSearch::asciiToUpper(u(row), (ULONG) row.length(), (UCHAR*) &fastUpper[0]);
+
+			fastSum += (UCHAR) fastUpper[i % ROW_LENGTH];
+		}
+	});
+
+	BOOST_TEST(plainUpper == fastUpper);
+	BOOST_TEST(plainSum == fastSum);
+	BOOST_TEST_MESSAGE("UPPER over " << ROWS << " rows of " << ROW_LENGTH <<
+		" bytes: plain " << plain << " ms, StringSearch::asciiToUpper " << fast << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// StringSearchBenchmarks
+
+
+BOOST_AUTO_TEST_SUITE_END()	// StringSearchSuite
+BOOST_AUTO_TEST_SUITE_END()	// CommonSuite
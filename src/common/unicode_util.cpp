@@ -2084,6 +2084,25 @@ void UnicodeUtil::Utf16Collation::normalize(ULONG* strLen, const USHORT** str, b
 
 	if (attributes & TEXTTYPE_ATTR_CASE_INSENSITIVE)
 	{
+		const ULONG len = *strLen / sizeof(USHORT);
+		const USHORT* const src = *str;
+		ULONG asciiLen = 0;
+
+		while (asciiLen < len && src[asciiLen] < 0x80)
+			++asciiLen;
+
+		if (asciiLen == len)
+		{
+			// ASCII has neither accents nor special case mappings, ICU is not needed
+			USHORT* const dst = buffer.getBuffer(len);
+
+			for (ULONG i = 0; i < len; ++i)
+				dst[i] = (src[i] >= 'a' && src[i] <= 'z') ? src[i] - 'a' + 'A' : src[i];
+
+			*str = dst;
+			return;
+		}
+
 		*strLen = utf16UpperCase(*strLen, *str, *strLen,
 			buffer.getBuffer(*strLen / sizeof(USHORT)), NULL);
 		*str = buffer.begin();
@@ -335,6 +335,320 @@ bool_t xdr_datum( xdr_t* xdrs, const dsc* desc, UCHAR* buffer)
 }
 
 
+// Compact representation of message items, see xdr_compact_datum()
+
+static bool_t xdr_varint(xdr_t* xdrs, FB_UINT64* ip)
+{
+/**************************************
+ *
+ *	x d r _ v a r i n t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Map unsigned integer as a sequence of 7-bit groups, least
+ *	significant first, with the high bit set in all but the last byte.
+ *
+ **************************************/
+	UCHAR buffer[10];
+
+	switch (xdrs->x_op)
+	{
+	case XDR_ENCODE:
+		{
+			FB_UINT64 value = *ip;
+			unsigned n = 0;
+
+			while (value >= 0x80)
+			{
+				buffer[n++] = (UCHAR) (value | 0x80);
+				value >>= 7;
+			}
+			buffer[n++] = (UCHAR) value;
+
+			return PUTBYTES(reinterpret_cast<SCHAR*>(buffer), n);
+		}
+
+	case XDR_DECODE:
+		{
+			FB_UINT64 value = 0;
+
+			for (unsigned shift = 0; shift < 64; shift += 7)
+			{
+				if (!GETBYTES(reinterpret_cast<SCHAR*>(buffer), 1))
+					return FALSE;
+
+				value |= (FB_UINT64) (buffer[0] & 0x7F) << shift;
+
+				if (!(buffer[0] & 0x80))
+				{
+					*ip = value;
+					return TRUE;
+				}
+			}
+
+			return FALSE;	// malformed
+		}
+
+	case XDR_FREE:
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+template <typename T>
+static bool_t xdr_compact_signed(xdr_t* xdrs, T* ip)
+{
+	// Zigzag encoding keeps small negative numbers short
+
+	FB_UINT64 temp = 0;
+
+	if (xdrs->x_op == XDR_ENCODE)
+	{
+		const SINT64 value = *ip;
+		temp = ((FB_UINT64) value << 1) ^ (FB_UINT64) (value >> 63);
+	}
+
+	if (!xdr_varint(xdrs, &temp))
+		return FALSE;
+
+	if (xdrs->x_op == XDR_DECODE)
+		*ip = (T) (SINT64) ((temp >> 1) ^ (~(temp & 1) + 1));
+
+	return TRUE;
+}
+
+
+template <typename T>
+static bool_t xdr_compact_unsigned(xdr_t* xdrs, T* ip)
+{
+	FB_UINT64 temp = 0;
+
+	if (xdrs->x_op == XDR_ENCODE)
+		temp = *ip;
+
+	if (!xdr_varint(xdrs, &temp))
+		return FALSE;
+
+	if (xdrs->x_op == XDR_DECODE)
+		*ip = (T) temp;
+
+	return TRUE;
+}
+
+
+static bool_t xdr_compact_length(xdr_t* xdrs, USHORT* length, USHORT limit)
+{
+	if (!xdr_compact_unsigned(xdrs, length))
+		return FALSE;
+
+	return *length <= limit;
+}
+
+
+static bool_t xdr_little_endian(xdr_t* xdrs, UCHAR* p, unsigned size)
+{
+	// Floating point items are passed in little endian byte order
+
+#ifndef WORDS_BIGENDIAN
+	if (xdrs->x_op == XDR_ENCODE)
+		return PUTBYTES(reinterpret_cast<SCHAR*>(p), size);
+
+	return GETBYTES(reinterpret_cast<SCHAR*>(p), size);
+#else
+	UCHAR temp[sizeof(double)];
+	fb_assert(size <= sizeof(temp));
+
+	if (xdrs->x_op == XDR_ENCODE)
+	{
+		for (unsigned i = 0; i < size; i++)
+			temp[i] = p[size - 1 - i];
+
+		return PUTBYTES(reinterpret_cast<SCHAR*>(temp), size);
+	}
+
+	if (!GETBYTES(reinterpret_cast<SCHAR*>(temp), size))
+		return FALSE;
+
+	for (unsigned i = 0; i < size; i++)
+		p[i] = temp[size - 1 - i];
+
+	return TRUE;
+#endif
+}
+
+
+bool_t xdr_compact_datum(xdr_t* xdrs, const dsc* desc, UCHAR* buffer)
+{
+/**************************************
+ *
+ *	x d r _ c o m p a c t _ d a t u m
+ *
+ **************************************
+ *
+ * Functional description
+ *	Map from external to internal representation (or vice versa)
+ *	without XDR alignment. Integers are sent as variable length
+ *	numbers, floating point numbers in little endian byte order,
+ *	CHAR items without their trailing padding and VARCHAR items
+ *	without unused space. Types having no shorter form are
+ *	handled by xdr_datum().
+ *
+ **************************************/
+	if (xdrs->x_op == XDR_FREE)
+		return TRUE;
+
+	BLOB_PTR* p = buffer + (IPTR) desc->dsc_address;
+
+	switch (desc->dsc_dtype)
+	{
+	case dtype_dbkey:
+		fb_assert(false);	// dbkey should not get outside jrd,
+		// but in case it happenned in production server treat it as text
+		// Fall through ...
+
+	case dtype_text:
+		{
+			// Padding is restored by the receiver, so trimming is lossless
+			// for any character set
+			const UCHAR pad = (desc->getCharSet() == CS_BINARY) ? 0 : ' ';
+			USHORT length = desc->dsc_length;
+
+			if (xdrs->x_op == XDR_ENCODE)
+			{
+				while (length && p[length - 1] == pad)
+					length--;
+			}
+
+			if (!xdr_compact_length(xdrs, &length, desc->dsc_length))
+				return FALSE;
+
+			if (xdrs->x_op == XDR_ENCODE)
+				return PUTBYTES(reinterpret_cast<SCHAR*>(p), length);
+
+			if (!GETBYTES(reinterpret_cast<SCHAR*>(p), length))
+				return FALSE;
+
+			memset(p + length, pad, desc->dsc_length - length);
+		}
+		break;
+
+	case dtype_boolean:
+		if (xdrs->x_op == XDR_ENCODE)
+			return PUTBYTES(reinterpret_cast<SCHAR*>(p), desc->dsc_length);
+		return GETBYTES(reinterpret_cast<SCHAR*>(p), desc->dsc_length);
+
+	case dtype_varying:
+		{
+			fb_assert(desc->dsc_length >= sizeof(USHORT));
+			vary* v = reinterpret_cast<vary*>(p);
+			const USHORT maxLength = desc->dsc_length - sizeof(USHORT);
+			USHORT length = MIN(maxLength, v->vary_length);
+
+			if (!xdr_compact_length(xdrs, &length, maxLength))
+				return FALSE;
+
+			if (xdrs->x_op == XDR_ENCODE)
+				return PUTBYTES(v->vary_string, length);
+
+			if (!GETBYTES(v->vary_string, length))
+				return FALSE;
+
+			v->vary_length = length;
+			memset(v->vary_string + length, 0, maxLength - length);
+		}
+		break;
+
+	case dtype_cstring:
+		{
+			const USHORT maxLength = desc->dsc_length - 1;
+			USHORT length = 0;
+
+			if (xdrs->x_op == XDR_ENCODE)
+				length = MIN(static_cast<ULONG>(strlen(reinterpret_cast<char*>(p))), (ULONG) maxLength);
+
+			if (!xdr_compact_length(xdrs, &length, maxLength))
+				return FALSE;
+
+			if (xdrs->x_op == XDR_ENCODE)
+				return PUTBYTES(reinterpret_cast<SCHAR*>(p), length);
+
+			if (!GETBYTES(reinterpret_cast<SCHAR*>(p), length))
+				return FALSE;
+
+			p[length] = 0;
+		}
+		break;
+
+	case dtype_short:
+		fb_assert(desc->dsc_length >= sizeof(SSHORT));
+		return xdr_compact_signed(xdrs, reinterpret_cast<SSHORT*>(p));
+
+	case dtype_sql_date:
+	case dtype_long:
+		fb_assert(desc->dsc_length >= sizeof(SLONG));
+		return xdr_compact_signed(xdrs, reinterpret_cast<SLONG*>(p));
+
+	case dtype_sql_time:
+		fb_assert(desc->dsc_length >= sizeof(ULONG));
+		return xdr_compact_unsigned(xdrs, reinterpret_cast<ULONG*>(p));
+
+	case dtype_sql_time_tz:
+	case dtype_ex_time_tz:
+		fb_assert(desc->dsc_length >= sizeof(ULONG) + sizeof(SSHORT));
+		if (!xdr_compact_unsigned(xdrs, reinterpret_cast<ULONG*>(p)))
+			return FALSE;
+		if (!xdr_compact_signed(xdrs, reinterpret_cast<SSHORT*>(p + sizeof(ULONG))))
+			return FALSE;
+		if (desc->dsc_dtype == dtype_ex_time_tz &&
+			!xdr_compact_signed(xdrs, reinterpret_cast<SSHORT*>(p + sizeof(ULONG) + sizeof(SSHORT))))
+		{
+			return FALSE;
+		}
+		break;
+
+	case dtype_timestamp:
+	case dtype_timestamp_tz:
+	case dtype_ex_timestamp_tz:
+		fb_assert(desc->dsc_length >= 2 * sizeof(SLONG));
+		if (!xdr_compact_signed(xdrs, &((SLONG*) p)[0]))
+			return FALSE;
+		if (!xdr_compact_unsigned(xdrs, &((ULONG*) p)[1]))
+			return FALSE;
+		if (desc->dsc_dtype != dtype_timestamp &&
+			!xdr_compact_signed(xdrs, reinterpret_cast<SSHORT*>(p + 2 * sizeof(SLONG))))
+		{
+			return FALSE;
+		}
+		if (desc->dsc_dtype == dtype_ex_timestamp_tz &&
+			!xdr_compact_signed(xdrs, reinterpret_cast<SSHORT*>(p + 2 * sizeof(SLONG) + sizeof(SSHORT))))
+		{
+			return FALSE;
+		}
+		break;
+
+	case dtype_int64:
+		fb_assert(desc->dsc_length >= sizeof(SINT64));
+		return xdr_compact_signed(xdrs, reinterpret_cast<SINT64*>(p));
+
+	case dtype_real:
+		fb_assert(desc->dsc_length >= sizeof(float));
+		return xdr_little_endian(xdrs, p, sizeof(float));
+
+	case dtype_double:
+		fb_assert(desc->dsc_length >= sizeof(double));
+		return xdr_little_endian(xdrs, p, sizeof(double));
+
+	default:
+		return xdr_datum(xdrs, desc, buffer);
+	}
+
+	return TRUE;
+}
+
+
 bool_t xdr_double(xdr_t* xdrs, double* ip)
 {
 /**************************************
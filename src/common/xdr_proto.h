@@ -28,6 +28,7 @@
 #include "../common/xdr.h"
 
 bool_t	xdr_datum(xdr_t*, const dsc*, UCHAR*);
+bool_t	xdr_compact_datum(xdr_t*, const dsc*, UCHAR*);
 bool_t	xdr_double(xdr_t*, double*);
 bool_t	xdr_dec64(xdr_t*, Firebird::Decimal64*);
 bool_t	xdr_dec128(xdr_t*, Firebird::Decimal128*);
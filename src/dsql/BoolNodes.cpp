@@ -126,6 +126,30 @@ namespace
 		return true;
 	}
 
+	// Get the value of an exact numeric descriptor having the given scale.
+	bool getExactValue(const dsc* desc, SSHORT scale, SINT64* value)
+	{
+		if (desc->dsc_scale != scale)
+			return false;
+
+		switch (desc->dsc_dtype)
+		{
+			case dtype_short:
+				*value = *reinterpret_cast<const SSHORT*>(desc->dsc_address);
+				return true;
+
+			case dtype_long:
+				*value = *reinterpret_cast<const SLONG*>(desc->dsc_address);
+				return true;
+
+			case dtype_int64:
+				*value = *reinterpret_cast<const SINT64*>(desc->dsc_address);
+				return true;
+		}
+
+		return false;
+	}
+
 } // namespace
 
 
@@ -382,7 +406,10 @@ ComparativeBoolNode::ComparativeBoolNode(MemoryPool& pool, UCHAR aBlrOp,
 	  arg1(aArg1),
 	  arg2(aArg2),
 	  arg3(aArg3),
-	  dsqlSpecialArg(nullptr)
+	  dsqlSpecialArg(nullptr),
+	  exactConstant(0),
+	  exactScale(0),
+	  exactComparison(false)
 {
 }
 
@@ -395,7 +422,10 @@ ComparativeBoolNode::ComparativeBoolNode(MemoryPool& pool, UCHAR aBlrOp,
 	  arg1(aArg1),
 	  arg2(nullptr),
 	  arg3(nullptr),
-	  dsqlSpecialArg(aSpecialArg)
+	  dsqlSpecialArg(aSpecialArg),
+	  exactConstant(0),
+	  exactScale(0),
+	  exactComparison(false)
 {
 }
 
@@ -721,6 +751,45 @@ void ComparativeBoolNode::pass2Boolean(thread_db* tdbb, CompilerScratch* csb, st
 	else if (DTYPE_IS_DATE(descriptor_b.dsc_dtype))
 		arg1->nodFlags |= FLAG_DATE;
 
+	// Exact numeric value compared with a literal: bring the literal to the scale
+	// of the value once here instead of converting both of them in every execution.
+	// The literal may be rescaled only up to the precision of the value.
+
+	const LiteralNode* literal;
+	SINT64 constant;
+
+	switch (blrOp)
+	{
+		case blr_eql:
+		case blr_gtr:
+		case blr_geq:
+		case blr_lss:
+		case blr_leq:
+		case blr_neq:
+			if ((literal = nodeAs<LiteralNode>(arg2)) && !nodeIs<RecordKeyNode>(arg1) &&
+				getExactValue(&literal->litDesc, literal->litDesc.dsc_scale, &constant) &&
+				descriptor_a.isExact() && descriptor_a.dsc_dtype != dtype_int128 &&
+				descriptor_a.dsc_scale <= literal->litDesc.dsc_scale)
+			{
+				exactComparison = true;
+
+				for (SSHORT scale = descriptor_a.dsc_scale; scale < literal->litDesc.dsc_scale; ++scale)
+				{
+					if (constant > MAX_SINT64 / 10 || constant < MIN_SINT64 / 10)
+					{
+						exactComparison = false;
+						break;
+					}
+
+					constant *= 10;
+				}
+
+				exactConstant = constant;
+				exactScale = descriptor_a.dsc_scale;
+			}
+			break;
+	}
+
 	if (nodFlags & FLAG_INVARIANT)
 		impureOffset = csb->allocImpure<impure_value>();
 	// Do not use FLAG_PATTERN_MATCHER_CACHE for blr_starting as it has very fast compilation.
@@ -750,6 +819,39 @@ bool ComparativeBoolNode::execute(thread_db* tdbb, Request* request) const
 	request->req_flags &= ~req_null;
 	bool force_equal = (request->req_flags & req_same_tx_upd) != 0;
 
+	// Comparison with the literal prepared by pass2Boolean, unless the value came
+	// in an unexpected type or scale (for example, from an older record format)
+
+	SINT64 exactValue;
+
+	if (exactComparison && !null1 && getExactValue(desc[0], exactScale, &exactValue))
+	{
+		request->req_flags &= ~(req_null | req_same_tx_upd);
+
+		switch (blrOp)
+		{
+			case blr_eql:
+				return exactValue == exactConstant;
+
+			case blr_gtr:
+				return exactValue > exactConstant;
+
+			case blr_geq:
+				return exactValue >= exactConstant;
+
+			case blr_lss:
+				return exactValue < exactConstant;
+
+			case blr_leq:
+				return exactValue <= exactConstant;
+
+			case blr_neq:
+				return exactValue != exactConstant;
+		}
+
+		fb_assert(false);
+	}
+
 	// Currently only nod_like, nod_contains, nod_starts and nod_similar may be marked invariant
 	if (nodFlags & FLAG_INVARIANT)
 	{
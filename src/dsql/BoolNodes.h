@@ -138,6 +138,11 @@ public:
 	NestConst<ValueExprNode> arg2;
 	NestConst<ValueExprNode> arg3;
 	NestConst<ExprNode> dsqlSpecialArg;	// list or select expression
+
+private:
+	SINT64 exactConstant;	// literal arg2 in the scale of an exact numeric arg1
+	SSHORT exactScale;
+	bool exactComparison;
 };
 
 
@@ -28,6 +28,8 @@
 #include "../jrd/jrd.h"
 #include "../jrd/status.h"
 #include "../jrd/exe_proto.h"
+#include "../jrd/IndexKeyBatch.h"
+#include "../jrd/tra.h"
 #include "../dsql/dsql.h"
 #include "../dsql/errd_proto.h"
 #include "../common/classes/ClumpletWriter.h"
@@ -58,6 +60,79 @@ namespace {
 	private:
 		thread_db* m_tdbb;
 	};
+
+	// Secondary index keys of the records stored by a batched INSERT. They are
+	// loaded in key order between messages, once they take enough memory, and
+	// after the last message, instead of descending the b-trees for every record.
+	// Every message keeps its own savepoint: keys of a failed message are dropped
+	// together with its undone record, while the records of the processed messages
+	// stay, so if their keys cannot be loaded the transaction is invalidated.
+
+	class BatchIndexKeys
+	{
+	public:
+		BatchIndexKeys(thread_db* tdbb, jrd_tra* transaction, Request* request, bool enabled)
+			: m_tdbb(tdbb), m_transaction(transaction),
+			  m_keys(enabled ? FB_NEW_POOL(*tdbb->getDefaultPool()) IndexKeyBatch(*tdbb->getDefaultPool()) : nullptr),
+			  m_autoKeys(&request->req_batch_keys, m_keys)
+		{ }
+
+		~BatchIndexKeys()
+		{
+			// Some messages were processed before an error, their records stay
+
+			if (m_keys && !m_keys->isEmpty())
+			{
+				try
+				{
+					load();
+				}
+				catch (const Exception&)
+				{}	// the original error is more interesting
+			}
+		}
+
+		IndexKeyBatch::Mark getMark() const
+		{
+			const IndexKeyBatch::Mark empty = {0, 0};
+			return m_keys ? m_keys->getMark() : empty;
+		}
+
+		void rollback(const IndexKeyBatch::Mark& mark)
+		{
+			if (m_keys)
+				m_keys->rollback(mark);
+		}
+
+		void loadIfFull()
+		{
+			if (m_keys && m_keys->isFull())
+				load();
+		}
+
+		void load()
+		{
+			if (!m_keys)
+				return;
+
+			try
+			{
+				m_keys->flush(m_tdbb, m_transaction);
+			}
+			catch (const Exception&)
+			{
+				m_keys->clear();
+				m_transaction->tra_flags |= TRA_invalidated;
+				throw;
+			}
+		}
+
+	private:
+		thread_db* m_tdbb;
+		jrd_tra* m_transaction;
+		AutoPtr<IndexKeyBatch> m_keys;
+		AutoSetRestore<IndexKeyBatch*> m_autoKeys;
+	};
 }
 
 DsqlBatch::DsqlBatch(DsqlDmlRequest* req, const dsql_msg* /*message*/, IMessageMetadata* inMeta, ClumpletReader& pb)
@@ -671,6 +746,8 @@ private:
 	bool isExecBlock = dStmt->getType() == DsqlStatement::TYPE_EXEC_BLOCK;
 	const dsql_msg* receiveMessage = isExecBlock ? dStmt->getReceiveMsg() : nullptr;
 
+	BatchIndexKeys batchKeys(tdbb, transaction, req, dStmt->getType() == DsqlStatement::TYPE_INSERT);
+
 	// process messages
 	ULONG remains;
 	UCHAR* data;
@@ -725,6 +802,8 @@ private:
 				*id = newId;
 			}
 
+			const IndexKeyBatch::Mark keysMark = batchKeys.getMark();
+
 			try
 			{
 				// runsend data to request and collect stats
@@ -740,6 +819,9 @@ private:
 			}
 			catch (const Exception& ex)
 			{
+				// The record of the message is undone by the request savepoint
+				batchKeys.rollback(keysMark);
+
 				FbLocalStatus status;
 				ex.stuffException(&status);
 				tdbb->tdbb_status_vector->init();
@@ -757,6 +839,8 @@ private:
 				startRequest = true;
 			}
 
+			batchKeys.loadIfFull();
+
 			data += m_messageSize;
 			remains -= m_messageSize;
 		}
@@ -765,6 +849,8 @@ private:
 		m_messages.remained(remains, alignedData - data);
 	}
 
+	batchKeys.load();
+
 	DEB_BATCH(fprintf(stderr, "Sent %d messages\n", completionState->getSize(tdbb->tdbb_status_vector)));
 
 	// make sure all blobs were used in messages
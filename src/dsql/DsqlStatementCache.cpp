@@ -31,6 +31,12 @@
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	// Longest statement text whose lookup key is built in the reused buffer
+	const FB_SIZE_T MAX_REUSED_KEY_TEXT = 4096;
+}
+
 
 // Class DsqlStatementCache
 
@@ -38,7 +44,8 @@ DsqlStatementCache::DsqlStatementCache(MemoryPool& o, Attachment* attachment)
 	: PermanentStorage(o),
 	  map(o),
 	  activeStatementList(o),
-	  inactiveStatementList(o)
+	  inactiveStatementList(o),
+	  lookupKey(FB_NEW_POOL(o) RefString(o))
 {
 	const auto dbb = attachment->att_database;
 	maxCacheSize = dbb->dbb_config->getMaxStatementCacheSize();
@@ -73,8 +80,14 @@ int DsqlStatementCache::blockingAst(void* astObject)
 RefPtr<DsqlStatement> DsqlStatementCache::getStatement(thread_db* tdbb, const string& text, USHORT clientDialect,
 	bool isInternalRequest)
 {
-	RefStrPtr key;
-	buildStatementKey(tdbb, key, text, clientDialect, isInternalRequest);
+	// A rare long statement gets a key of its own, so that the reused buffer does not
+	// keep its size for the rest of the attachment
+
+	RefStrPtr key(lookupKey);
+	if (text.length() > MAX_REUSED_KEY_TEXT)
+		key = FB_NEW_POOL(getPool()) RefString(getPool());
+
+	buildStatementKey(tdbb, *key, text, clientDialect, isInternalRequest);
 
 	if (const auto entryPtr = map.get(key))
 	{
@@ -93,7 +106,7 @@ RefPtr<DsqlStatement> DsqlStatementCache::getStatement(thread_db* tdbb, const st
 
 		if (!entry->active)
 		{
-			entry->dsqlStatement->setCacheKey(key);
+			entry->dsqlStatement->setCacheKey(entry->key);
 			// Active statement has cacheKey and will tell us when it's going to be released.
 			entry->dsqlStatement->release();
 
@@ -131,8 +144,8 @@ void DsqlStatementCache::putStatement(thread_db* tdbb, const string& text, USHOR
 
 	const unsigned statementSize = dsqlStatement->getSize();
 
-	RefStrPtr key;
-	buildStatementKey(tdbb, key, text, clientDialect, isInternalRequest);
+	RefStrPtr key(FB_NEW_POOL(getPool()) RefString(getPool()));
+	buildStatementKey(tdbb, *key, text, clientDialect, isInternalRequest);
 
 	StatementEntry newStatement(getPool());
 	newStatement.key = key;
@@ -254,7 +267,7 @@ void DsqlStatementCache::purgeAllAttachments(thread_db* tdbb)
 	LCK_release(tdbb, &tempLock);
 }
 
-void DsqlStatementCache::buildStatementKey(thread_db* tdbb, RefStrPtr& key, const string& text, USHORT clientDialect,
+void DsqlStatementCache::buildStatementKey(thread_db* tdbb, string& key, const string& text, USHORT clientDialect,
 	bool isInternalRequest)
 {
 	const auto attachment = tdbb->getAttachment();
@@ -262,10 +275,8 @@ void DsqlStatementCache::buildStatementKey(thread_db* tdbb, RefStrPtr& key, cons
 	const SSHORT charSetId = isInternalRequest ? CS_METADATA : attachment->att_charset;
 	const int debugOptions = (int) attachment->getDebugOptions().getDsqlKeepBlr();
 
-	key = FB_NEW_POOL(getPool()) RefString(getPool());
-
-	key->resize(1 + sizeof(charSetId) + text.length());
-	char* p = key->begin();
+	key.resize(1 + sizeof(charSetId) + text.length());
+	char* p = key.begin();
 	*p = (clientDialect << 2) | (int(isInternalRequest) << 1) | debugOptions;
 	memcpy(p + 1, &charSetId, sizeof(charSetId));
 	memcpy(p + 1 + sizeof(charSetId), text.c_str(), text.length());
@@ -118,7 +118,7 @@ public:
 	}
 
 private:
-	void buildStatementKey(thread_db* tdbb, Firebird::RefStrPtr& key, const Firebird::string& text,
+	void buildStatementKey(thread_db* tdbb, Firebird::string& key, const Firebird::string& text,
 		USHORT clientDialect, bool isInternalRequest);
 
 	void buildVerifyKey(thread_db* tdbb, Firebird::string& key, bool isInternalRequest);
@@ -138,6 +138,7 @@ private:
 	Firebird::DoublyLinkedList<StatementEntry> activeStatementList;
 	Firebird::DoublyLinkedList<StatementEntry> inactiveStatementList;
 	Firebird::AutoPtr<Lock> lock;
+	Firebird::RefStrPtr lookupKey;		// reused by getStatement() to avoid allocation per lookup
 	unsigned maxCacheSize = 0;
 	unsigned cacheSize = 0;
 };
@@ -33,6 +33,7 @@
 #include "firebird/impl/blr.h"
 #include "../jrd/tra.h"
 #include "../jrd/Function.h"
+#include "../jrd/ResultCache.h"
 #include "../jrd/SysFunction.h"
 #include "../jrd/recsrc/RecordSource.h"
 #include "../jrd/recsrc/Cursor.h"
@@ -178,7 +179,8 @@ namespace
 	// referencing, and mark them as variant - the rule is that if a field from one RSE is
 	// referenced within the scope of another RSE, the inner RSE can't be invariant.
 	// This won't optimize all cases, but it is the simplest operating assumption for now.
-	void markVariant(CompilerScratch* csb, StreamType stream)
+	// The node referencing the stream is remembered by the marked RSEs as their outer value.
+	void markVariant(CompilerScratch* csb, StreamType stream, ValueExprNode* value = nullptr)
 	{
 		if (csb->csb_current_nodes.isEmpty())
 			return;
@@ -192,11 +194,75 @@ namespace
 					break;
 
 				rseNode->flags |= RseNode::FLAG_VARIANT;
+				rseNode->addOuterValue(csb->csb_pool, value);
 			}
 			else if (*node)
 				(*node)->nodFlags &= ~ExprNode::FLAG_INVARIANT;
 		}
 	}
+
+	// Let all RSEs being processed know they depend on a value coming from outside of them.
+	// NULL means a dependency on something else, e.g. a sequence or a non-deterministic function.
+	void addOuterValue(CompilerScratch* csb, ValueExprNode* value)
+	{
+		for (const auto node : csb->csb_current_nodes)
+		{
+			if (const auto rseNode = nodeAs<RseNode>(node))
+				rseNode->addOuterValue(csb->csb_pool, value);
+		}
+	}
+
+	// Add the current value an RSE depends on to the key of its memoized result.
+	// Values are read from their sources, as the nodes remembered during pass1
+	// are not guaranteed to have their impure area allocated.
+	void addOuterKey(thread_db* tdbb, Request* request, const ValueExprNode* node, ResultCache* cache)
+	{
+		if (const auto fieldNode = nodeAs<FieldNode>(node))
+		{
+			const record_param& rpb = request->req_rpb[fieldNode->fieldStream];
+			dsc desc;
+
+			if (rpb.rpb_record && EVL_field(rpb.rpb_relation, rpb.rpb_record, fieldNode->fieldId, &desc))
+				cache->addKey(&desc);
+			else
+				cache->addKey(nullptr);
+		}
+		else if (const auto variableNode = nodeAs<VariableNode>(node))
+		{
+			const auto varImpure = request->getImpure<impure_value>(variableNode->varDecl->impureOffset);
+
+			if ((varImpure->vlu_flags & VLU_initialized) && !(varImpure->vlu_desc.dsc_flags & DSC_null))
+				cache->addKey(&varImpure->vlu_desc);
+			else
+				cache->addKey(nullptr);
+		}
+		else if (const auto paramNode = nodeAs<ParameterNode>(node))
+		{
+			// Parameters of routines may be assigned to, read them from the message
+
+			const auto paramRequest = paramNode->getParamRequest(request);
+			const auto format = paramNode->message->getFormat(paramRequest);
+			UCHAR* const buffer = paramNode->message->getBuffer(paramRequest);
+
+			if (const auto flagNode = paramNode->argFlag.getObject())
+			{
+				dsc flag = format->fmt_desc[flagNode->argNumber];
+				flag.dsc_address = buffer + (IPTR) flag.dsc_address;
+
+				if (MOV_get_long(tdbb, &flag, 0))
+				{
+					cache->addKey(nullptr);
+					return;
+				}
+			}
+
+			dsc desc = format->fmt_desc[paramNode->argNumber];
+			desc.dsc_address = buffer + (IPTR) desc.dsc_address;
+			cache->addKey(&desc);
+		}
+		else
+			fb_assert(false);
+	}
 }
 
 namespace Jrd {
@@ -6762,7 +6828,7 @@ ValueExprNode* FieldNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 		if (relation && (relation->rel_flags & REL_being_scanned))
 			csb->csb_g_flags |= csb_reload;
 
-		markVariant(csb, stream);
+		markVariant(csb, stream, this);
 		return ValueExprNode::pass1(tdbb, csb);
 	}
 
@@ -6842,7 +6908,7 @@ ValueExprNode* FieldNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 	{
 		if (!relation->rel_view_rse)
 		{
-			markVariant(csb, stream);
+			markVariant(csb, stream, this);
 			return ValueExprNode::pass1(tdbb, csb);
 		}
 
@@ -6866,7 +6932,7 @@ ValueExprNode* FieldNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 		//			want their old/new contexts to be substituted
 		if (relation->rel_view_rse || !field->fld_computation)
 		{
-			markVariant(csb, stream);
+			markVariant(csb, stream, this);
 			return ValueExprNode::pass1(tdbb, csb);
 		}
 	}
@@ -7238,6 +7304,9 @@ ValueExprNode* GenIdNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 {
 	ValueExprNode::pass1(tdbb, csb);
 
+	// Every evaluation gives a new value, so nothing depending on it may be reused.
+	addOuterValue(csb, nullptr);
+
 	if (!identity)
 	{
 		CMP_post_access(tdbb, csb, generator.secName, 0,
@@ -9881,6 +9950,10 @@ ParameterNode* ParameterNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 			status_exception::raise(Arg::Gds(isc_ctxnotdef) << Arg::Gds(isc_random) << Arg::Str("Outer parameter has no outer scratch"));
 	}
 
+	// Input parameters of routines are assignable, so the memoized results
+	// of enclosing RSEs must depend on their current values
+	addOuterValue(csb, this);
+
 	return this;
 }
 
@@ -10876,7 +10949,7 @@ dsc* StrCaseNode::execute(thread_db* tdbb, Request* request) const
 		blb* blob = blb::open(tdbb, tdbb->getRequest()->req_transaction,
 			reinterpret_cast<bid*>(value->dsc_address));
 
-		HalfStaticArray<UCHAR, BUFFER_MEDIUM> buffer;
+		ArenaBuffer<BUFFER_MEDIUM> buffer(request->req_arena);
 
 		if (charSet->isMultiByte())
 		{
@@ -11103,7 +11176,7 @@ dsc* StrLenNode::execute(thread_db* tdbb, Request* request) const
 
 				if (charSet->isMultiByte())
 				{
-					HalfStaticArray<UCHAR, BUFFER_LARGE> buffer;
+					ArenaBuffer<BUFFER_LARGE> buffer(request->req_arena);
 
 					length = blob->BLB_get_data(tdbb, buffer.getBuffer(blob->blb_length),
 						blob->blb_length, false);
@@ -11498,13 +11571,23 @@ ValueExprNode* SubQueryNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 
 	ValueExprNode::pass2(tdbb, csb);
 
-	impureOffset = csb->allocImpure<impure_value_ex>();
+	impureOffset = csb->allocImpure<Impure>();
 
 	{
 		dsc desc;
 		getDesc(tdbb, csb, &desc);
 	}
 
+	// Memoize a correlated sub-query by the outer values it depends on.
+	// Its cache is reset at the request start, like the invariants are.
+
+	if (!(nodFlags & FLAG_INVARIANT) && rse->isKeyed() &&
+		tdbb->getDatabase()->dbb_config->getResultCache())
+	{
+		cacheKeys = rse->rse_outer_values;
+		csb->csb_invariants.push(&impureOffset);
+	}
+
 	if (blrOp == blr_average && !(nodFlags & FLAG_DECFLOAT))
 		nodFlags |= FLAG_DOUBLE;
 
@@ -11535,7 +11618,8 @@ ValueExprNode* SubQueryNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 // Evaluate a subquery expression.
 dsc* SubQueryNode::execute(thread_db* tdbb, Request* request) const
 {
-	impure_value* impure = request->getImpure<impure_value>(impureOffset);
+	Impure* const impureArea = request->getImpure<Impure>(impureOffset);
+	impure_value* impure = &impureArea->value;
 	request->req_flags &= ~req_null;
 
 	dsc* desc = &impure->vlu_desc;
@@ -11558,6 +11642,47 @@ dsc* SubQueryNode::execute(thread_db* tdbb, Request* request) const
 		}
 	}
 
+	ResultCache* cache = NULL;
+
+	if (cacheKeys)
+	{
+		if (!impureArea->cache)
+		{
+			impureArea->cache =
+				FB_NEW_POOL(*tdbb->getDefaultPool()) ResultCache(*tdbb->getDefaultPool());
+		}
+
+		// Results of the previous request execution are not valid anymore
+
+		if (!(impure->vlu_flags & VLU_computed))
+		{
+			impureArea->cache->clear();
+			impure->vlu_flags |= VLU_computed;
+		}
+
+		if (impureArea->cache->begin(tdbb))
+		{
+			cache = impureArea->cache;
+
+			for (const auto value : *cacheKeys)
+				addOuterKey(tdbb, request, value, cache);
+
+			if (const auto result = cache->find())
+			{
+				dsc cached;
+
+				if (!ResultCache::getValue(*result, &cached))
+				{
+					request->req_flags |= req_null;
+					return NULL;
+				}
+
+				EVL_make_value(tdbb, &cached, impure);
+				return &impure->vlu_desc;
+			}
+		}
+	}
+
 	impure->vlu_misc.vlu_long = 0;
 	impure->vlu_desc.dsc_dtype = dtype_long;
 	impure->vlu_desc.dsc_length = sizeof(SLONG);
@@ -11680,6 +11805,9 @@ dsc* SubQueryNode::execute(thread_db* tdbb, Request* request) const
 	request->req_flags &= ~req_null;
 	request->req_flags |= flag;
 
+	if (cache)
+		cache->storeValue((request->req_flags & req_null) ? NULL : desc);
+
 	// If this is an invariant node, save the return value. If the descriptor does not point to the
 	// impure area for this node then point this node's descriptor to the correct place;
 	// Copy the whole structure to be absolutely sure.
@@ -11917,7 +12045,8 @@ dsc* SubstringNode::perform(thread_db* tdbb, impure_value* impure, const dsc* va
 		blb* blob = blb::open(tdbb, tdbb->getRequest()->req_transaction,
 			reinterpret_cast<bid*>(valueDsc->dsc_address));
 
-		HalfStaticArray<UCHAR, BUFFER_LARGE> buffer;
+		RequestArena& arena = tdbb->getRequest()->req_arena;
+		ArenaBuffer<BUFFER_LARGE> buffer(arena);
 		CharSet* charSet = INTL_charset_lookup(tdbb, valueDsc->getCharSet());
 
 		const FB_UINT64 byte_offset = start * charSet->maxBytesPerChar();
@@ -11928,7 +12057,7 @@ dsc* SubstringNode::perform(thread_db* tdbb, impure_value* impure, const dsc* va
 			buffer.getBuffer(MIN(blob->blb_length, byte_offset + byte_length));
 			dataLen = blob->BLB_get_data(tdbb, buffer.begin(), buffer.getCount(), false);
 
-			HalfStaticArray<UCHAR, BUFFER_LARGE> buffer2;
+			ArenaBuffer<BUFFER_LARGE> buffer2(arena);
 			buffer2.getBuffer(dataLen);
 
 			dataLen = charSet->substring(dataLen, buffer.begin(),
@@ -12472,6 +12601,16 @@ bool SysFuncCallNode::sameAs(const ExprNode* other, bool ignoreStreams) const
 	return function && function == otherNode->function;
 }
 
+ValueExprNode* SysFuncCallNode::pass1(thread_db* tdbb, CompilerScratch* csb)
+{
+	ValueExprNode::pass1(tdbb, csb);
+
+	if (!function->deterministic)
+		addOuterValue(csb, nullptr);
+
+	return this;
+}
+
 ValueExprNode* SysFuncCallNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 {
 	ValueExprNode::pass2(tdbb, csb);
@@ -13420,6 +13559,9 @@ ValueExprNode* UdfCallNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 		CMP_post_resource(&csb->csb_resources, function, Resource::rsc_function, function->getId());
 	}
 
+	if (!function->fun_deterministic)
+		addOuterValue(csb, nullptr);
+
 	return this;
 }
 
@@ -13447,6 +13589,14 @@ ValueExprNode* UdfCallNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 			nodFlags |= FLAG_INVARIANT;
 			csb->csb_invariants.push(&impureOffset);
 		}
+		else if (!function->fun_entrypoint && !function->getOutputFields()[0]->prm_desc.isBlob() &&
+			tdbb->getDatabase()->dbb_config->getResultCache())
+		{
+			// Otherwise memoize its results by the input message, the cache being
+			// reset at the request start. Returned blobs may be temporary ones.
+			cacheResults = true;
+			csb->csb_invariants.push(&impureOffset);
+		}
 	}
 
 	ValueExprNode::pass2(tdbb, csb);
@@ -13562,9 +13712,36 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 
 		const ULONG inMsgLength = function->getInputFormat() ? function->getInputFormat()->fmt_length : 0;
 		const ULONG outMsgLength = function->getOutputFormat()->fmt_length;
-		UCHAR* const inMsg = FB_ALIGN(impure + sizeof(impure_value), FB_ALIGNMENT);
+		UCHAR* const inMsg = FB_ALIGN(impure + sizeof(Impure), FB_ALIGNMENT);
 		UCHAR* const outMsg = FB_ALIGN(inMsg + inMsgLength, FB_ALIGNMENT);
 
+		ResultCache* cache = NULL;
+
+		if (cacheResults)
+		{
+			if (!impureArea->cache)
+			{
+				impureArea->cache =
+					FB_NEW_POOL(*tdbb->getDefaultPool()) ResultCache(*tdbb->getDefaultPool());
+			}
+
+			// Results of the previous request execution are not valid anymore
+
+			if (!(invariantFlags & VLU_computed))
+			{
+				impureArea->cache->clear();
+				invariantFlags |= VLU_computed;
+			}
+
+			if (impureArea->cache->begin(tdbb))
+			{
+				cache = impureArea->cache;
+
+				// The message is the key, so its gaps must not contain garbage
+				memset(inMsg, 0, inMsgLength);
+			}
+		}
+
 		if (function->fun_inputs != 0)
 		{
 			const dsc* fmtDesc = function->getInputFormat()->fmt_desc.begin();
@@ -13592,6 +13769,34 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 			}
 		}
 
+		if (cache)
+		{
+			cache->addKey(inMsg, inMsgLength);
+
+			if (const auto result = cache->find())
+			{
+				// Take the output message of the previous call with the same input
+
+				memcpy(outMsg, result->begin(), outMsgLength);
+
+				const dsc* fmtDesc = function->getOutputFormat()->fmt_desc.begin();
+
+				if (*reinterpret_cast<SSHORT*>(outMsg + (IPTR) fmtDesc[1].dsc_address))
+				{
+					request->req_flags |= req_null;
+					return NULL;
+				}
+
+				request->req_flags &= ~req_null;
+
+				value->vlu_desc = *fmtDesc;
+				value->vlu_desc.dsc_address = outMsg + (IPTR) fmtDesc[0].dsc_address;
+				INTL_adjust_text_descriptor(tdbb, &value->vlu_desc);
+
+				return &value->vlu_desc;
+			}
+		}
+
 		jrd_tra* transaction = request->req_transaction;
 
 		const SavNumber savNumber = transaction->tra_save_point ?
@@ -13657,6 +13862,9 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 			trace.finish(ITracePlugin::RESULT_SUCCESS, &value->vlu_desc);
 		}
 
+		if (cache)
+			cache->store(outMsg, outMsgLength);
+
 		EXE_unwind(tdbb, funcRequest);
 
 		funcRequest->req_attachment = NULL;
@@ -14197,6 +14405,9 @@ ValueExprNode* VariableNode::pass1(thread_db* tdbb, CompilerScratch* csb)
 	if (!vector || varId >= vector->count() || !(varDecl = (*vector)[varId]))
 		status_exception::raise(Arg::Gds(isc_badvarnum));
 
+	// Variables of the outer routine live in another request
+	addOuterValue(csb, outerDecl ? nullptr : this);
+
 	return this;
 }
 
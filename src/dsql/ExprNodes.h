@@ -39,6 +39,7 @@ class ItemInfo;
 class DeclareVariableNode;
 class SubQuery;
 class RelationSourceNode;
+class ResultCache;
 class ValueListNode;
 
 
@@ -1951,6 +1952,13 @@ public:
 // This node is used for DSQL subqueries and for legacy (BLR-only) functionality.
 class SubQueryNode final : public TypedNode<ValueExprNode, ExprNode::TYPE_SUBQUERY>
 {
+private:
+	struct Impure
+	{
+		impure_value_ex value;	// must be first
+		ResultCache* cache;
+	};
+
 public:
 	explicit SubQueryNode(MemoryPool& pool, UCHAR aBlrOp, SelectExprNode* aDsqlSelectExpr = NULL,
 		ValueExprNode* aValue1 = NULL, ValueExprNode* aValue2 = NULL);
@@ -2007,6 +2015,7 @@ public:
 	NestConst<ValueExprNode> value1;
 	NestConst<ValueExprNode> value2;
 	NestConst<SubQuery> subQuery;
+	const Firebird::Array<ValueExprNode*>* cacheKeys = nullptr;	// outer values the result is memoized by
 	const UCHAR blrOp;
 	bool ownSavepoint;
 };
@@ -2116,6 +2125,7 @@ public:
 	virtual ValueExprNode* copy(thread_db* tdbb, NodeCopier& copier) const;
 	virtual bool dsqlMatch(DsqlCompilerScratch* dsqlScratch, const ExprNode* other, bool ignoreMapCast) const;
 	virtual bool sameAs(const ExprNode* other, bool ignoreStreams) const;
+	virtual ValueExprNode* pass1(thread_db* tdbb, CompilerScratch* csb);
 	virtual ValueExprNode* pass2(thread_db* tdbb, CompilerScratch* csb);
 	virtual dsc* execute(thread_db* tdbb, Request* request) const;
 
@@ -2173,6 +2183,7 @@ private:
 	{
 		impure_value value;	// must be first
 		Firebird::Array<UCHAR>* temp;
+		ResultCache* cache;
 	};
 
 public:
@@ -2223,6 +2234,7 @@ public:
 private:
 	dsql_udf* dsqlFunction = nullptr;
 	bool isSubRoutine = false;
+	bool cacheResults = false;	// memoize the results by the input message
 };
 
 
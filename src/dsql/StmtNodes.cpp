@@ -34,6 +34,7 @@
 #include "../jrd/tra.h"
 #include "../jrd/Coercion.h"
 #include "../jrd/Function.h"
+#include "../jrd/IndexKeyBatch.h"
 #include "../jrd/optimizer/Optimizer.h"
 #include "../jrd/RecordSourceNodes.h"
 #include "../jrd/VirtualTable.h"
@@ -117,6 +118,10 @@ static void validateExpressions(thread_db* tdbb, const Array<ValidateInfo>& vali
 
 namespace
 {
+	// INSERT ... SELECT expected to store fewer records is not worth the bulk insert mode,
+	// as the latter takes empty data pages only and locks pointer pages exclusively.
+	const double BULK_INSERT_MIN_CARDINALITY = 10000.0;
+
 	// Node copier that remaps the field id 0 of stream 0 to a given field id.
 	class RemapFieldNodeCopier : public NodeCopier
 	{
@@ -5710,6 +5715,16 @@ StmtNode* ForNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 
 	RecordSource* const rsb = CMP_post_rse(tdbb, csb, rse.getObject());
 
+	if (const auto storeNode = nodeAs<StoreNode>(statement))
+	{
+		if ((storeNode->marks & StmtNode::MARK_BULK_INSERT) &&
+			rsb->getCardinality() < BULK_INSERT_MIN_CARDINALITY)
+		{
+			storeNode->marks &= ~StmtNode::MARK_BULK_INSERT;
+			storeNode->deferIndexKeys = false;
+		}
+	}
+
 	MetaName cursorName;
 	csb->csb_forCursorNames.get(this, cursorName);
 
@@ -8876,6 +8891,13 @@ void StoreNode::genBlr(DsqlCompilerScratch* dsqlScratch)
 	if (overrideClause.has_value())
 		dsqlScratch->appendUChar(UCHAR(overrideClause.value()));
 
+	// INSERT ... SELECT may store many records at once. Let the engine store them
+	// in the bulk mode, i.e. fill its own data pages one after another without
+	// competing for free space with concurrent inserters, if the estimated
+	// cardinality of the source is large enough.
+	if (dsqlRse && !dsqlScratch->isPsql())
+		dsqlScratch->putBlrMarkers(MARK_BULK_INSERT);
+
 	GEN_expr(dsqlScratch, target);
 
 	statement->genBlr(dsqlScratch);
@@ -9130,6 +9152,29 @@ StoreNode* StoreNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 		ExprNode::doPass2(tdbb, csb, i->value.getAddress());
 	}
 
+	// Bulk insert may postpone the secondary index keys until the end of the looper run,
+	// and so may a batch until its messages are processed, unless the statement could
+	// look for the stored records using these indices, i.e. the target table is
+	// referenced somewhere else (a validation sub-query included) or some routine is called.
+
+	const StreamType stream = target->getStream();
+	jrd_rel* const relation = csb->csb_rpt[stream].csb_relation;
+
+	deferIndexKeys = relation && !subStore && !validationsReadStreams(validations, stream) &&
+		!relation->rel_file && !relation->isVirtual() && !relation->rel_view_rse && !relation->isSystem();
+
+	for (StreamType i = 0; deferIndexKeys && i < csb->csb_n_stream; i++)
+	{
+		if (i != stream && csb->csb_rpt[i].csb_relation == relation)
+			deferIndexKeys = false;
+	}
+
+	for (const auto& resource : csb->csb_resources)
+	{
+		if (resource.rsc_type == Resource::rsc_procedure || resource.rsc_type == Resource::rsc_function)
+			deferIndexKeys = false;
+	}
+
 	impureOffset = csb->allocImpure<impure_state>();
 
 	return this;
@@ -9178,6 +9223,25 @@ const StmtNode* StoreNode::execute(thread_db* tdbb, Request* request, ExeState*
 	return retNode;
 }
 
+// Check if some validation reads other streams than the stored one, i.e. has a sub-query that
+// could look for the stored records. NOT NULL checks and domain CHECKs over VALUE only don't.
+bool StoreNode::validationsReadStreams(const Array<ValidateInfo>& validations, StreamType stream)
+{
+	for (const auto& validation : validations)
+	{
+		SortedStreamList streams;
+		validation.boolean->collectStreams(streams);
+
+		for (const auto validationStream : streams)
+		{
+			if (validationStream != stream)
+				return true;
+		}
+	}
+
+	return false;
+}
+
 // Execute a STORE statement.
 const StmtNode* StoreNode::store(thread_db* tdbb, Request* request, WhichTrigger whichTrig) const
 {
@@ -9244,9 +9308,36 @@ const StmtNode* StoreNode::store(thread_db* tdbb, Request* request, WhichTrigger
 					VirtualTable::store(tdbb, rpb);
 				else if (!relation->rel_view_rse)
 				{
+					// Triggers could look for the stored records, so don't defer index keys then
+
+					IndexKeyBatch* indexKeys = NULL;
+
+					if (deferIndexKeys && !relation->rel_pre_store && !relation->rel_post_store)
+					{
+						if (!(marks & MARK_BULK_INSERT))
+						{
+							// A batch loads the keys itself, between its messages
+							if (request->req_batch_mode)
+								indexKeys = request->req_batch_keys;
+						}
+						else if (!request->req_batch_mode)
+						{
+							if (!request->req_index_keys)
+							{
+								request->req_index_keys =
+									FB_NEW_POOL(*request->req_pool) IndexKeyBatch(*request->req_pool);
+							}
+
+							indexKeys = request->req_index_keys;
+						}
+					}
+
 					VIO_store(tdbb, rpb, transaction);
-					IDX_store(tdbb, rpb, transaction);
+					IDX_store(tdbb, rpb, transaction, indexKeys);
 					REPL_store(tdbb, rpb, transaction);
+
+					if (indexKeys && indexKeys == request->req_index_keys && indexKeys->isFull())
+						indexKeys->flush(tdbb, transaction);
 				}
 
 				rpb->rpb_number.setValid(true);
@@ -1351,7 +1351,8 @@ public:
 		: TypedNode<StmtNode, StmtNode::TYPE_STORE>(pool),
 		  dsqlFields(pool),
 		  validations(pool),
-		  marks(0)
+		  marks(0),
+		  deferIndexKeys(false)
 	{
 	}
 
@@ -1366,6 +1367,8 @@ public:
 	virtual StoreNode* pass2(thread_db* tdbb, CompilerScratch* csb);
 	virtual const StmtNode* execute(thread_db* tdbb, Request* request, ExeState* exeState) const;
 
+	static bool validationsReadStreams(const Firebird::Array<ValidateInfo>& validations, StreamType stream);
+
 private:
 	static bool pass1Store(thread_db* tdbb, CompilerScratch* csb, StoreNode* node);
 	void makeDefaults(thread_db* tdbb, CompilerScratch* csb);
@@ -1382,6 +1385,7 @@ public:
 	NestConst<StmtNode> subStore;
 	Firebird::Array<ValidateInfo> validations;
 	unsigned marks;
+	bool deferIndexKeys;	// bulk insert or batch may load secondary index keys later
 	std::optional<USHORT> dsqlReturningLocalTableNumber;
 	std::optional<OverrideClause> overrideClause;
 };
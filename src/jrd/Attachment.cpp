@@ -30,6 +30,7 @@
 #include "../jrd/nbak.h"
 #include "../jrd/trace/TraceManager.h"
 #include "../jrd/PreparedStatement.h"
+#include "../jrd/SimilarToCache.h"
 #include "../jrd/tra.h"
 #include "../jrd/intl.h"
 
@@ -235,6 +236,7 @@ Jrd::Attachment::Attachment(MemoryPool* pool, Database* dbb, JProvider* provider
 	  att_backup_state_counter(0),
 	  att_stats(*pool),
 	  att_base_stats(*pool),
+	  att_data_changes(0),
 	  att_working_directory(*pool),
 	  att_filename(*pool),
 	  att_timestamp(TimeZoneUtil::getCurrentSystemTimeStamp()),
@@ -808,6 +810,7 @@ void Jrd::Attachment::releaseLocks(thread_db* tdbb)
 					if (index->idl_lock)
 					{
 						index->idl_count = 0;
+						index->idl_blocking = false;
 						LCK_release(tdbb, index->idl_lock);
 					}
 				}
@@ -78,6 +78,7 @@ namespace Jrd
 	class jrd_file;
 	class Format;
 	class BufferControl;
+	class SimilarToCache;
 	class PageToBufferMap;
 	class SparseBitmap;
 	class jrd_rel;
@@ -590,6 +591,7 @@ public:
 	SecurityClassList*	att_security_classes;	// security classes
 	RuntimeStatistics	att_stats;
 	RuntimeStatistics	att_base_stats;
+	FB_UINT64	att_data_changes;			// Sequence of data changes and their undo, see ResultCache
 	ULONG		att_flags;					// Flags describing the state of the attachment
 	SSHORT		att_client_charset;			// user's charset specified in dpb
 	SSHORT		att_charset;				// current (client or external) attachment charset
@@ -646,6 +648,7 @@ public:
 	Firebird::TriState att_opt_first_rows;
 
 	PageToBufferMap* att_bdb_cache;			// managed in CCH, created in att_pool, freed with it
+	Firebird::AutoPtr<SimilarToCache> att_similar_to_cache;	// compiled SIMILAR TO patterns
 
 	Firebird::RefPtr<Firebird::IReplicatedSession> att_replicator;
 	Firebird::AutoPtr<Replication::TableMatcher> att_repl_matcher;
@@ -102,7 +102,7 @@
 #include "../jrd/intl_proto.h"
 #include "../jrd/Collation.h"
 #include "../common/TextType.h"
-#include "../common/SimilarToRegex.h"
+#include "../jrd/SimilarToCache.h"
 
 using namespace Firebird;
 using namespace Jrd;
@@ -154,9 +154,16 @@ public:
 		else
 			flags |= SimilarToFlag::LATIN;
 
-		regex = FB_NEW_POOL(pool) SimilarToRegex(pool, flags,
+		regex = SimilarToCache::getSimilar(tdbb, flags,
 			(const char*) patternStr, patternLen,
 			(escapeStr ? (const char*) escapeStr : nullptr), escapeLen);
+
+		finalizer = pool.registerFinalizer(finalize, this);
+	}
+
+	virtual ~Re2SimilarMatcher()
+	{
+		pool.unregisterFinalizer(finalizer);
 	}
 
 public:
@@ -202,12 +209,19 @@ public:
 		if (textType->getAttributes() & TEXTTYPE_ATTR_ACCENT_INSENSITIVE)
 			UnicodeUtil::utf8Normalize(*bufferPtr);
 
-		return regex->matches((const char*) bufferPtr->begin(), bufferPtr->getCount());
+		return regex->getRegex()->matches((const char*) bufferPtr->begin(), bufferPtr->getCount());
 	}
 
 private:
+	// Matchers left in a pool being deleted release the shared program
+	static void finalize(Re2SimilarMatcher* self)
+	{
+		self->regex = nullptr;
+	}
+
 	CsConvert converter;
-	AutoPtr<SimilarToRegex> regex;
+	RefPtr<SimilarToCache::SimilarEntry> regex;
+	MemoryPool::Finalizer* finalizer = nullptr;
 	UCharBuffer buffer;
 };
 
@@ -257,13 +271,16 @@ public:
 		else
 			flags |= SimilarToFlag::LATIN;
 
-		regex = FB_NEW_POOL(pool) SubstringSimilarRegex(pool, flags,
+		regex = SimilarToCache::getSubstring(tdbb, flags,
 			(const char*) patternStr, patternLen,
 			(escapeStr ? (const char*) escapeStr : nullptr), escapeLen);
+
+		finalizer = pool.registerFinalizer(finalize, this);
 	}
 
 	virtual ~Re2SubstringSimilarMatcher()
 	{
+		pool.unregisterFinalizer(finalizer);
 	}
 
 public:
@@ -311,7 +328,8 @@ public:
 		if (textType->getAttributes() & TEXTTYPE_ATTR_ACCENT_INSENSITIVE)
 			UnicodeUtil::utf8Normalize(*bufferPtr);
 
-		if (!regex->matches((const char*) bufferPtr->begin(), bufferPtr->getCount(), &resultStart, &resultLength))
+		if (!regex->getRegex()->matches((const char*) bufferPtr->begin(), bufferPtr->getCount(),
+				&resultStart, &resultLength))
 			return false;
 
 		if (charSetId != CS_NONE && charSetId != CS_BINARY)
@@ -332,8 +350,14 @@ public:
 	}
 
 private:
+	static void finalize(Re2SubstringSimilarMatcher* self)
+	{
+		self->regex = nullptr;
+	}
+
 	CsConvert converter;
-	AutoPtr<SubstringSimilarRegex> regex;
+	RefPtr<SimilarToCache::SubstringEntry> regex;
+	MemoryPool::Finalizer* finalizer = nullptr;
 	UCharBuffer buffer;
 	unsigned resultStart, resultLength;
 };
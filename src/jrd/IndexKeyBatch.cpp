@@ -0,0 +1,196 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../jrd/jrd.h"
+#include "../jrd/btr.h"
+#include "../jrd/ods.h"
+#include "../jrd/tra.h"
+#include "../jrd/IndexKeyBatch.h"
+#include "../jrd/btr_proto.h"
+#include "../jrd/cch_proto.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+
+bool IndexKeyBatch::Entry::greaterThan(const Entry& i1, const Entry& i2)
+{
+	// Order by index, then by key value (byte-wise, as b-tree does) and
+	// then by record number, so that the flush walks every b-tree once
+
+	if (i1.index != i2.index)
+		return i1.index > i2.index;
+
+	const int result = memcmp(i1.data, i2.data, MIN(i1.length, i2.length));
+
+	if (result)
+		return result > 0;
+
+	if (i1.length != i2.length)
+		return i1.length > i2.length;
+
+	return i1.number > i2.number;
+}
+
+
+UCHAR* IndexKeyBatch::allocate(FB_SIZE_T length)
+{
+	fb_assert(length <= CHUNK_SIZE);
+
+	if (length > m_space)
+	{
+		m_chunks.add(FB_NEW_POOL(getPool()) UCHAR[CHUNK_SIZE]);
+		m_space = CHUNK_SIZE;
+		m_size += CHUNK_SIZE;
+	}
+
+	UCHAR* const ptr = m_chunks.back() + CHUNK_SIZE - m_space;
+	m_space -= length;
+	return ptr;
+}
+
+
+void IndexKeyBatch::add(jrd_rel* relation, USHORT index, RecordNumber number, const temporary_key* key)
+{
+	fb_assert(accepts(relation));
+	m_relation = relation;
+
+	Entry entry;
+	entry.data = NULL;
+	entry.number = number.getValue();
+	entry.index = index;
+	entry.length = key->key_length;
+	entry.nulls = key->key_nulls;
+	entry.flags = key->key_flags;
+
+	if (entry.length)
+	{
+		UCHAR* const data = allocate(entry.length);
+		memcpy(data, key->key_data, entry.length);
+		entry.data = data;
+	}
+
+	m_entries.add(entry);
+	m_size += sizeof(Entry);
+}
+
+
+void IndexKeyBatch::flush(thread_db* tdbb, jrd_tra* transaction)
+{
+/**************************************
+ *
+ *	f l u s h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert the collected keys into their indices in key order
+ *	and empty the batch.
+ *
+ **************************************/
+	if (m_entries.isEmpty())
+		return;
+
+	m_entries.sort();
+
+	RelationPages* const relPages = m_relation->getPages(tdbb, transaction->tra_number);
+
+	index_desc idx;
+	idx.idx_id = idx_invalid;
+	bool found = false;
+
+	temporary_key key;
+
+	index_insertion insertion;
+	insertion.iib_relation = m_relation;
+	insertion.iib_descriptor = &idx;
+	insertion.iib_key = &key;
+	insertion.iib_transaction = transaction;
+	insertion.iib_btr_level = 0;
+
+	for (const auto& entry : m_entries)
+	{
+		if (entry.index != idx.idx_id)
+		{
+			// The index may be gone since the keys were collected, skip its keys then
+			found = BTR_lookup(tdbb, m_relation, entry.index, &idx, relPages);
+			idx.idx_id = entry.index;
+		}
+
+		if (!found)
+			continue;
+
+		key.key_length = entry.length;
+		key.key_flags = entry.flags;
+		key.key_nulls = entry.nulls;
+
+		if (entry.length)
+			memcpy(key.key_data, entry.data, entry.length);
+
+		insertion.iib_number.setValue(entry.number);
+		insertion.iib_duplicates = NULL;
+
+		// BTR_insert expects the index root page to be fetched by the caller
+
+		WIN window(relPages->rel_pg_space_id, relPages->rel_index_root);
+		CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+		BTR_insert(tdbb, &window, &insertion);
+
+		fb_assert(!insertion.iib_duplicates);
+	}
+
+	clear();
+	m_flushes++;
+}
+
+
+void IndexKeyBatch::rollback(const Mark& mark)
+{
+/**************************************
+ *
+ *	r o l l b a c k
+ *
+ **************************************
+ *
+ * Functional description
+ *	Forget the keys collected after the mark.
+ *	Their memory is reclaimed by the next flush.
+ *
+ **************************************/
+	// If the batch was flushed in between, all the keys it holds came later
+
+	if (mark.flushes != m_flushes)
+		m_entries.clear();
+	else if (mark.count < m_entries.getCount())
+		m_entries.shrink(mark.count);
+}
+
+
+void IndexKeyBatch::clear()
+{
+	for (auto chunk : m_chunks)
+		delete[] chunk;
+
+	m_chunks.clear();
+	m_entries.clear();
+	m_relation = NULL;
+	m_space = m_size = 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef JRD_INDEX_KEY_BATCH_H
+#define JRD_INDEX_KEY_BATCH_H
+
+#include "../common/classes/alloc.h"
+#include "../common/classes/array.h"
+#include "../jrd/RecordNumber.h"
+
+namespace Jrd {
+
+class jrd_rel;
+class jrd_tra;
+class thread_db;
+struct temporary_key;
+
+// Keys of non-unique indices collected while a bulk insert is running.
+// Instead of descending the b-tree for every stored record, the keys are
+// accumulated in memory and inserted in key order when the batch is flushed,
+// so that consecutive insertions hit the same (already cached) leaf pages.
+
+class IndexKeyBatch : public Firebird::PermanentStorage
+{
+	static const FB_SIZE_T CHUNK_SIZE = 64 * 1024;			// key storage allocation unit
+	static const FB_SIZE_T MAX_BATCH_SIZE = 16 * 1024 * 1024;	// flush threshold
+
+	struct Entry
+	{
+		const UCHAR* data;
+		SINT64 number;
+		USHORT index;
+		USHORT length;
+		USHORT nulls;
+		UCHAR flags;
+
+		static bool greaterThan(const Entry& i1, const Entry& i2);
+	};
+
+	typedef Firebird::SortedArray<Entry, Firebird::EmptyStorage<Entry>,
+		Entry, Firebird::DefaultKeyValue<Entry>, Entry> EntryList;
+
+public:
+	// Position to return to when the records stored after it are undone
+	struct Mark
+	{
+		FB_UINT64 flushes;
+		FB_SIZE_T count;
+	};
+
+	explicit IndexKeyBatch(MemoryPool& pool)
+		: PermanentStorage(pool),
+		  m_relation(NULL), m_entries(pool), m_chunks(pool),
+		  m_space(0), m_size(0), m_flushes(0)
+	{
+		m_entries.setSortMode(Firebird::FB_ARRAY_SORT_MANUAL);
+	}
+
+	~IndexKeyBatch()
+	{
+		clear();
+	}
+
+	bool isEmpty() const
+	{
+		return m_entries.isEmpty();
+	}
+
+	bool isFull() const
+	{
+		return m_size >= MAX_BATCH_SIZE;
+	}
+
+	// All keys of the batch must belong to the same relation
+	bool accepts(const jrd_rel* relation) const
+	{
+		return !m_relation || m_relation == relation;
+	}
+
+	Mark getMark() const
+	{
+		const Mark mark = {m_flushes, m_entries.getCount()};
+		return mark;
+	}
+
+	void add(jrd_rel* relation, USHORT index, RecordNumber number, const temporary_key* key);
+	void flush(thread_db* tdbb, jrd_tra* transaction);
+	void rollback(const Mark& mark);
+	void clear();
+
+private:
+	UCHAR* allocate(FB_SIZE_T length);
+
+	jrd_rel* m_relation;
+	EntryList m_entries;
+	Firebird::HalfStaticArray<UCHAR*, 16> m_chunks;
+	FB_SIZE_T m_space;		// free space in the last chunk
+	FB_SIZE_T m_size;		// memory occupied by the batch
+	FB_UINT64 m_flushes;
+};
+
+} // namespace Jrd
+
+#endif // JRD_INDEX_KEY_BATCH_H
@@ -1622,6 +1622,14 @@ RecordSourceNode* ProcedureSourceNode::pass1(thread_db* tdbb, CompilerScratch* c
 	doPass1(tdbb, csb, inputSources.getAddress());
 	doPass1(tdbb, csb, inputTargets.getAddress());
 	doPass1(tdbb, csb, inputMessage.getAddress());
+
+	// The procedure may have side effects or read anything, so don't memoize the RSEs using it
+	for (const auto node : csb->csb_current_nodes)
+	{
+		if (const auto rseNode = nodeAs<RseNode>(node))
+			rseNode->addOuterValue(csb->csb_pool, nullptr);
+	}
+
 	return this;
 }
 
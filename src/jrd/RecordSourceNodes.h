@@ -726,7 +726,8 @@ public:
 		FLAG_LATERAL			= 0x20,		// lateral derived table
 		FLAG_SKIP_LOCKED		= 0x40,		// skip locked
 		FLAG_SUB_QUERY			= 0x80,		// sub-query
-		FLAG_SEMI_JOINED		= 0x100		// participates in semi-join
+		FLAG_SEMI_JOINED		= 0x100,	// participates in semi-join
+		FLAG_UNKEYED			= 0x200		// depends on something else than rse_outer_values
 	};
 
 	bool isInvariant() const
@@ -769,6 +770,29 @@ public:
 		return (flags & FLAG_SKIP_LOCKED) != 0;
 	}
 
+	// Results of a variant RSE depend on nothing but the values of rse_outer_values
+	bool isKeyed() const
+	{
+		return rse_outer_values && !(flags & FLAG_UNKEYED);
+	}
+
+	// Remember an outer value the RSE depends on,
+	// NULL if the dependency is not a value (e.g. a sequence)
+	void addOuterValue(MemoryPool& pool, ValueExprNode* value)
+	{
+		if (!value)
+		{
+			flags |= FLAG_UNKEYED;
+			return;
+		}
+
+		if (!rse_outer_values)
+			rse_outer_values = FB_NEW_POOL(pool) Firebird::Array<ValueExprNode*>(pool);
+
+		if (!rse_outer_values->exist(value))
+			rse_outer_values->add(value);
+	}
+
 	explicit RseNode(MemoryPool& pool)
 		: TypedNode<RecordSourceNode, RecordSourceNode::TYPE_RSE>(pool),
 		  rse_relations(pool)
@@ -802,6 +826,7 @@ public:
 		obj->rse_aggregate = rse_aggregate;
 		obj->rse_plan = rse_plan;
 		obj->rse_invariants = rse_invariants;
+		obj->rse_outer_values = rse_outer_values;
 		obj->flags = flags;
 		obj->rse_relations = rse_relations;
 		obj->firstRows = firstRows;
@@ -887,6 +912,7 @@ public:
 	NestConst<SortNode> rse_aggregate;	// singleton aggregate for optimizing to index
 	NestConst<PlanNode> rse_plan;		// user-specified access plan
 	NestConst<VarInvariantArray> rse_invariants; // Invariant nodes bound to top-level RSE
+	Firebird::Array<ValueExprNode*>* rse_outer_values = nullptr;	// values of outer scopes used
 	Firebird::Array<NestConst<RecordSourceNode> > rse_relations;
 	USHORT flags = 0;
 	USHORT rse_jointype = blr_inner;	// inner, left, full
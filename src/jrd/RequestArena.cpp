@@ -0,0 +1,133 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../jrd/RequestArena.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+
+RequestArena::~RequestArena()
+{
+	reset();
+}
+
+
+void RequestArena::addChunk(FB_SIZE_T length)
+{
+/**************************************
+ *
+ *	a d d C h u n k
+ *
+ **************************************
+ *
+ * Functional description
+ *	Make current a chunk having at least length bytes free.
+ *	Standard chunks are reused, larger ones are allocated on demand.
+ *
+ **************************************/
+	Chunk* chunk = NULL;
+
+	if (length <= CHUNK_SIZE && m_spare)
+	{
+		chunk = m_spare;
+		m_spare = chunk->next;
+	}
+	else
+	{
+		const FB_SIZE_T size = MAX(length, CHUNK_SIZE);
+
+		chunk = reinterpret_cast<Chunk*>(getPool().allocate(HEADER_SIZE + size ALLOC_ARGS));
+		chunk->size = size;
+	}
+
+	chunk->next = m_chunks;
+	m_chunks = chunk;
+	m_used = 0;
+}
+
+
+void RequestArena::freeChunk(Chunk* chunk)
+{
+	MemoryPool::globalFree(chunk);
+}
+
+
+void RequestArena::release(const Mark& mark)
+{
+/**************************************
+ *
+ *	r e l e a s e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Release everything allocated after the mark.
+ *	Standard chunks are kept for reuse, larger ones are freed.
+ *
+ **************************************/
+	while (m_chunks && m_chunks != mark.chunk)
+	{
+		Chunk* const chunk = m_chunks;
+		m_chunks = chunk->next;
+
+		if (chunk->size == CHUNK_SIZE)
+		{
+			chunk->next = m_spare;
+			m_spare = chunk;
+		}
+		else
+			freeChunk(chunk);
+	}
+
+	// Arena may be reset since the mark was taken
+	m_used = m_chunks ? mark.used : 0;
+}
+
+
+void RequestArena::reset()
+{
+/**************************************
+ *
+ *	r e s e t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return all the chunks to the pool, idle
+ *	requests don't keep arena memory.
+ *
+ **************************************/
+	while (m_chunks)
+	{
+		Chunk* const chunk = m_chunks;
+		m_chunks = chunk->next;
+		freeChunk(chunk);
+	}
+
+	while (m_spare)
+	{
+		Chunk* const chunk = m_spare;
+		m_spare = chunk->next;
+		freeChunk(chunk);
+	}
+
+	m_used = 0;
+}
@@ -0,0 +1,173 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef JRD_REQUEST_ARENA_H
+#define JRD_REQUEST_ARENA_H
+
+#include "../common/classes/alloc.h"
+
+namespace Jrd {
+
+// Bump allocator for temporaries of a request execution, which never outlive
+// the evaluation of a node. Memory is taken from the request pool in chunks,
+// released in LIFO order (see Scope) and kept for reuse until the request is
+// started again or unwound, then all of them are returned to the pool.
+
+class RequestArena : public Firebird::PermanentStorage
+{
+	static const FB_SIZE_T CHUNK_SIZE = 16 * 1024;
+
+	struct Chunk
+	{
+		Chunk* next;
+		FB_SIZE_T size;		// usable size
+
+		UCHAR* getData()
+		{
+			return reinterpret_cast<UCHAR*>(this) + HEADER_SIZE;
+		}
+	};
+
+	static const FB_SIZE_T HEADER_SIZE = FB_ALIGN(sizeof(Chunk), FB_ALIGNMENT);
+
+public:
+	// Position in the arena
+	struct Mark
+	{
+		Chunk* chunk;
+		FB_SIZE_T used;
+	};
+
+	// Releases memory allocated during its lifetime
+	class Scope
+	{
+	public:
+		explicit Scope(RequestArena& aArena)
+			: arena(aArena), mark(aArena.getMark())
+		{ }
+
+		~Scope()
+		{
+			arena.release(mark);
+		}
+
+		UCHAR* allocate(FB_SIZE_T length)
+		{
+			return arena.allocate(length);
+		}
+
+	private:
+		Scope(const Scope&);
+		Scope& operator=(const Scope&);
+
+		RequestArena& arena;
+		const Mark mark;
+	};
+
+	explicit RequestArena(MemoryPool& pool)
+		: PermanentStorage(pool),
+		  m_chunks(NULL), m_spare(NULL), m_used(0)
+	{ }
+
+	~RequestArena();
+
+	UCHAR* allocate(FB_SIZE_T length)
+	{
+		length = FB_ALIGN(length, FB_ALIGNMENT);
+
+		if (!m_chunks || m_chunks->size - m_used < length)
+			addChunk(length);
+
+		UCHAR* const ptr = m_chunks->getData() + m_used;
+		m_used += length;
+		return ptr;
+	}
+
+	Mark getMark() const
+	{
+		const Mark mark = {m_chunks, m_used};
+		return mark;
+	}
+
+	void release(const Mark& mark);
+	void reset();
+
+private:
+	void addChunk(FB_SIZE_T length);
+	void freeChunk(Chunk* chunk);
+
+	Chunk* m_chunks;		// chunks in use, current one first
+	Chunk* m_spare;			// released chunks of standard size
+	FB_SIZE_T m_used;		// space used in current chunk
+};
+
+
+// Buffer with inline part, spilling into request arena instead of the pool.
+// Mimics the part of HalfStaticArray used for temporary buffers. Buffers must
+// be released in LIFO order, i.e. an outer buffer must not grow while an inner
+// one is alive.
+
+template <FB_SIZE_T SIZE>
+class ArenaBuffer
+{
+public:
+	explicit ArenaBuffer(RequestArena& arena)
+		: scope(arena), data(inlineData), count(0), capacity(SIZE)
+	{ }
+
+	UCHAR* getBuffer(FB_SIZE_T length)
+	{
+		if (length > capacity)
+		{
+			UCHAR* const newData = scope.allocate(length);
+			memcpy(newData, data, count);
+			data = newData;
+			capacity = length;
+		}
+
+		count = length;
+		return data;
+	}
+
+	UCHAR* begin()
+	{
+		return data;
+	}
+
+	FB_SIZE_T getCount() const
+	{
+		return count;
+	}
+
+	FB_SIZE_T getCapacity() const
+	{
+		return capacity;
+	}
+
+private:
+	RequestArena::Scope scope;
+	UCHAR* data;
+	FB_SIZE_T count;
+	FB_SIZE_T capacity;
+	UCHAR inlineData[SIZE];
+};
+
+} // namespace Jrd
+
+#endif // JRD_REQUEST_ARENA_H
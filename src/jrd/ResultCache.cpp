@@ -0,0 +1,235 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+#include "firebird.h"
+#include "../jrd/ResultCache.h"
+#include "../jrd/jrd.h"
+#include "../jrd/Attachment.h"
+#include "../jrd/tra.h"
+#include "../jrd/val.h"
+#include "../common/classes/Hash.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+
+bool ResultCache::begin(thread_db* tdbb)
+{
+/**************************************
+ *
+ *	b e g i n
+ *
+ **************************************
+ *
+ * Functional description
+ *	Prepare for a new key. The results cached before
+ *	any data change made by the attachment are dropped.
+ *	Returns false if the results cannot be reused.
+ *
+ **************************************/
+	if (disabled)
+		return false;
+
+	// Without read consistency, commits of other transactions may change the results
+
+	const jrd_tra* const transaction = tdbb->getTransaction();
+
+	if (transaction && (transaction->tra_flags & TRA_read_committed) &&
+		!(transaction->tra_flags & TRA_read_consistency))
+	{
+		return false;
+	}
+
+	const FB_UINT64 currentChanges = getChanges(tdbb);
+
+	if (currentChanges != changes)
+	{
+		clear();
+		changes = currentChanges;
+	}
+
+	key.clear();
+	current = NULL;
+
+	return true;
+}
+
+
+void ResultCache::clear()
+{
+	for (auto& slot : slots)
+	{
+		slot.key.clear();
+		slot.result.clear();
+	}
+
+	current = NULL;
+}
+
+
+void ResultCache::addKey(const UCHAR* data, ULONG length)
+{
+	key.push(data, length);
+}
+
+
+void ResultCache::addKey(const dsc* desc)
+{
+	if (!desc)
+	{
+		key.add(0);
+		return;
+	}
+
+	const UCHAR header[] = {1, desc->dsc_dtype, (UCHAR) desc->dsc_scale,
+		(UCHAR) desc->dsc_sub_type, (UCHAR) (desc->dsc_sub_type >> 8),
+		(UCHAR) desc->dsc_length, (UCHAR) (desc->dsc_length >> 8)};
+	key.push(header, sizeof(header));
+
+	if (desc->dsc_dtype == dtype_varying)
+	{
+		const vary* const string = reinterpret_cast<const vary*>(desc->dsc_address);
+		key.push(reinterpret_cast<const UCHAR*>(string), sizeof(USHORT) + string->vary_length);
+	}
+	else
+		key.push(desc->dsc_address, desc->dsc_length);
+}
+
+
+const Array<UCHAR>* ResultCache::find()
+{
+/**************************************
+ *
+ *	f i n d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Look for the result of the key built. Caching is
+ *	turned off if too few results are found again.
+ *
+ **************************************/
+	current = NULL;
+
+	if (key.hasData() && key.getCount() <= MAX_KEY_LENGTH)
+	{
+		while (slots.getCount() < SLOTS)
+			slots.add();
+
+		Slot& slot = slots[DefaultHash<UCHAR>::hash(key.begin(), key.getCount(), SLOTS)];
+
+		if (slot.key.getCount() == key.getCount() &&
+			memcmp(slot.key.begin(), key.begin(), key.getCount()) == 0)
+		{
+			++hits;
+			return &slot.result;
+		}
+
+		current = &slot;
+	}
+
+	++misses;
+
+	if (hits + misses >= PROBATION && hits * 100 < (hits + misses) * MIN_HIT_PERCENT)
+	{
+		disabled = true;
+		clear();
+	}
+
+	return NULL;
+}
+
+
+void ResultCache::store(const UCHAR* result, ULONG length)
+{
+	if (current && length <= MAX_RESULT_LENGTH)
+	{
+		current->key.assign(key.begin(), key.getCount());
+		current->result.assign(result, length);
+	}
+
+	current = NULL;
+}
+
+
+bool ResultCache::getValue(const Array<UCHAR>& result, dsc* desc)
+{
+/**************************************
+ *
+ *	g e t V a l u e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Get the value stored by storeValue(),
+ *	return false for NULL.
+ *
+ **************************************/
+	fb_assert(result.getCount() >= sizeof(dsc));
+
+	memcpy(desc, result.begin(), sizeof(dsc));
+
+	if (desc->dsc_flags & DSC_null)
+		return false;
+
+	desc->dsc_address = const_cast<UCHAR*>(result.begin()) + sizeof(dsc);
+	return true;
+}
+
+
+void ResultCache::storeValue(const dsc* desc)
+{
+	// Blob IDs may refer to temporary blobs which do not outlive the request
+
+	const ULONG length = desc ? desc->dsc_length : 0;
+
+	if (!current || (desc && desc->isBlob()) || sizeof(dsc) + length > MAX_RESULT_LENGTH)
+	{
+		current = NULL;
+		return;
+	}
+
+	dsc header;
+
+	if (desc)
+	{
+		header = *desc;
+		header.dsc_address = NULL;
+	}
+	else
+	{
+		header.clear();
+		header.dsc_flags = DSC_null;
+	}
+
+	current->key.assign(key.begin(), key.getCount());
+	current->result.assign(reinterpret_cast<const UCHAR*>(&header), sizeof(dsc));
+
+	if (length)
+		current->result.push(desc->dsc_address, length);
+
+	current = NULL;
+}
+
+
+FB_UINT64 ResultCache::getChanges(thread_db* tdbb)
+{
+	// Bumped by inserts, updates and deletes as well as by their undo
+	// (backouts, in-place restores of savepoint rollback, transaction rollback)
+	return tdbb->getAttachment()->att_data_changes;
+}
@@ -0,0 +1,99 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+#ifndef JRD_RESULT_CACHE_H
+#define JRD_RESULT_CACHE_H
+
+#include "../common/classes/objects_array.h"
+#include "../common/dsc.h"
+
+namespace Jrd {
+
+class thread_db;
+
+// Results of a correlated sub-query or a deterministic function call memoized
+// by the values they depend on. The cache belongs to the impure area of a node,
+// holds a bounded number of small results and stops caching when it does not
+// pay back. Everything is forgotten as soon as the attachment changes any data
+// or undoes a change.
+
+class ResultCache : public Firebird::PermanentStorage
+{
+	static const FB_SIZE_T SLOTS = 256;
+	static const FB_SIZE_T MAX_KEY_LENGTH = 256;
+	static const FB_SIZE_T MAX_RESULT_LENGTH = 1024;
+	static const FB_UINT64 PROBATION = 1000;	// lookups before the hit ratio is judged
+	static const unsigned MIN_HIT_PERCENT = 10;
+
+	struct Slot
+	{
+		explicit Slot(MemoryPool& pool)
+			: key(pool),
+			  result(pool)
+		{ }
+
+		Firebird::Array<UCHAR> key;
+		Firebird::Array<UCHAR> result;
+	};
+
+public:
+	explicit ResultCache(MemoryPool& pool)
+		: PermanentStorage(pool),
+		  slots(pool),
+		  key(pool),
+		  changes(0),
+		  hits(0),
+		  misses(0),
+		  current(NULL),
+		  disabled(false)
+	{ }
+
+	// Start a lookup for the current execution, returns false if caching is off
+	bool begin(thread_db* tdbb);
+
+	// Forget the results of the previous request execution
+	void clear();
+
+	// Build the key
+	void addKey(const UCHAR* data, ULONG length);
+	void addKey(const dsc* desc);
+
+	// Find the result for the key built, the slot is remembered for store()
+	const Firebird::Array<UCHAR>* find();
+
+	void store(const UCHAR* result, ULONG length);
+
+	// Serialized descriptor for find() and store()
+	static bool getValue(const Firebird::Array<UCHAR>& result, dsc* desc);
+	void storeValue(const dsc* desc);
+
+private:
+	static FB_UINT64 getChanges(thread_db* tdbb);
+
+	Firebird::ObjectsArray<Slot> slots;
+	Firebird::UCharBuffer key;
+	FB_UINT64 changes;	// data changes of the attachment when the results were cached
+	FB_UINT64 hits;
+	FB_UINT64 misses;
+	Slot* current;
+	bool disabled;
+};
+
+} // namespace Jrd
+
+#endif // JRD_RESULT_CACHE_H
@@ -25,6 +25,7 @@
 #include "../jrd/dfw_proto.h"
 #include "../jrd/dpm_proto.h"
 #include "../jrd/idx_proto.h"
+#include "../jrd/sqz.h"
 #include "../jrd/vio_proto.h"
 
 #include "Savepoint.h"
@@ -38,9 +39,42 @@ using namespace Jrd;
 UndoItem::UndoItem(jrd_tra* transaction, RecordNumber recordNumber, const Record* record)
 	: m_number(recordNumber.getValue()), m_format(record->getFormat())
 {
+	// Undo images are kept RLE-compressed, the same way as records are stored
+	// on data pages. Huge UPDATE/DELETE statements may post millions of undo
+	// records and most of them (NULL fields, padded strings) compress well.
+
 	fb_assert(m_format);
-	m_offset = transaction->getUndoSpace()->allocateSpace(m_format->fmt_length);
-	transaction->getUndoSpace()->write(m_offset, record->getData(), record->getLength());
+
+	const ULONG length = record->getLength();
+	const UCHAR* const data = record->getData();
+	fb_assert(length == m_format->fmt_length);
+
+	const Compressor dcc(*transaction->tra_pool, true, true, length, data);
+	m_length = dcc.getPackedLength();
+
+	TempSpace* const space = transaction->getUndoSpace();
+	m_offset = space->allocateSpace(m_length);
+
+	if (!dcc.isPacked())
+	{
+		fb_assert(m_length == length);
+		space->write(m_offset, data, length);
+		return;
+	}
+
+	fb_assert(isPacked());
+
+	// Pack directly into the undo space if it's still memory resident
+
+	if (UCHAR* const memory = space->inMemory(m_offset, m_length))
+	{
+		dcc.pack(data, memory);
+		return;
+	}
+
+	UCHAR* const buffer = transaction->getUndoBuffer(m_length);
+	dcc.pack(data, buffer);
+	space->write(m_offset, buffer, m_length);
 }
 
 Record* UndoItem::setupRecord(jrd_tra* transaction) const
@@ -48,7 +82,29 @@ Record* UndoItem::setupRecord(jrd_tra* transaction) const
 	if (m_format)
 	{
 		Record* const record = transaction->getUndoRecord(m_format);
-		transaction->getUndoSpace()->read(m_offset, record->getData(), record->getLength());
+		TempSpace* const space = transaction->getUndoSpace();
+
+		if (!isPacked())
+		{
+			space->read(m_offset, record->getData(), record->getLength());
+			return record;
+		}
+
+		const UCHAR* packed = space->inMemory(m_offset, m_length);
+
+		if (!packed)
+		{
+			UCHAR* const buffer = transaction->getUndoBuffer(m_length);
+			space->read(m_offset, buffer, m_length);
+			packed = buffer;
+		}
+
+		const UCHAR* const end = Compressor::unpack(m_length, packed,
+			record->getLength(), record->getData());
+
+		if (end != record->getData() + record->getLength())
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+
 		return record;
 	}
 
@@ -59,7 +115,7 @@ void UndoItem::release(jrd_tra* transaction)
 {
 	if (m_format)
 	{
-		transaction->getUndoSpace()->releaseSpace(m_offset, m_format->fmt_length);
+		transaction->getUndoSpace()->releaseSpace(m_offset, m_length);
 		m_format = NULL;
 	}
 }
@@ -40,11 +40,11 @@ namespace Jrd
 		}
 
 		UndoItem()
-			: m_number(0), m_offset(0), m_format(NULL)
+			: m_number(0), m_offset(0), m_length(0), m_format(NULL)
 		{}
 
 		UndoItem(RecordNumber recordNumber)
-			: m_number(recordNumber.getValue()), m_offset(0), m_format(NULL)
+			: m_number(recordNumber.getValue()), m_offset(0), m_length(0), m_format(NULL)
 		{}
 
 		UndoItem(jrd_tra* transaction, RecordNumber recordNumber, const Record* record);
@@ -68,8 +68,15 @@ namespace Jrd
 		}
 
 	private:
+		bool isPacked() const
+		{
+			// Unpacked images are stored as is, with their full format length
+			return (m_length < m_format->fmt_length);
+		}
+
 		SINT64 m_number;
 		offset_t m_offset;
+		ULONG m_length;					// length of the stored (possibly packed) image
 		const Format* m_format;
 	};
 
@@ -0,0 +1,128 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../jrd/SimilarToCache.h"
+#include "../jrd/jrd.h"
+#include "../jrd/Attachment.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+
+SimilarToCache::~SimilarToCache()
+{
+	for (auto entry : similarEntries)
+		entry->release();
+
+	for (auto entry : substringEntries)
+		entry->release();
+}
+
+
+SimilarToCache* SimilarToCache::getCache(thread_db* tdbb)
+{
+	Attachment* const attachment = tdbb->getAttachment();
+
+	if (!attachment)
+		return NULL;
+
+	if (!attachment->att_similar_to_cache)
+	{
+		attachment->att_similar_to_cache =
+			FB_NEW_POOL(*attachment->att_pool) SimilarToCache(*attachment->att_pool);
+	}
+
+	return attachment->att_similar_to_cache;
+}
+
+
+RefPtr<SimilarToCache::SimilarEntry> SimilarToCache::getSimilar(thread_db* tdbb, unsigned flags,
+	const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen)
+{
+	SimilarToCache* const cache = getCache(tdbb);
+
+	if (!cache)
+	{
+		return RefPtr<SimilarEntry>(FB_NEW_POOL(*tdbb->getDefaultPool())
+			SimilarEntry(*tdbb->getDefaultPool(), flags, patternStr, patternLen, escapeStr, escapeLen));
+	}
+
+	return cache->get(cache->similarEntries, flags, patternStr, patternLen, escapeStr, escapeLen);
+}
+
+
+RefPtr<SimilarToCache::SubstringEntry> SimilarToCache::getSubstring(thread_db* tdbb, unsigned flags,
+	const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen)
+{
+	SimilarToCache* const cache = getCache(tdbb);
+
+	if (!cache)
+	{
+		return RefPtr<SubstringEntry>(FB_NEW_POOL(*tdbb->getDefaultPool())
+			SubstringEntry(*tdbb->getDefaultPool(), flags, patternStr, patternLen, escapeStr, escapeLen));
+	}
+
+	return cache->get(cache->substringEntries, flags, patternStr, patternLen, escapeStr, escapeLen);
+}
+
+
+template <typename E>
+RefPtr<E> SimilarToCache::get(Array<E*>& entries, unsigned flags,
+	const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen)
+{
+/**************************************
+ *
+ *	g e t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Find the compiled pattern or compile it,
+ *	evicting the least recently used one.
+ *
+ **************************************/
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	for (FB_SIZE_T i = 0; i < entries.getCount(); i++)
+	{
+		E* const entry = entries[i];
+
+		if (entry->isFor(flags, patternStr, patternLen, escapeStr, escapeLen))
+		{
+			if (i > 0)
+			{
+				entries.remove(i);
+				entries.insert(0, entry);
+			}
+
+			return RefPtr<E>(entry);
+		}
+	}
+
+	RefPtr<E> entry(FB_NEW_POOL(getPool()) E(getPool(), flags, patternStr, patternLen, escapeStr, escapeLen));
+
+	if (entries.getCount() >= MAX_ENTRIES)
+		entries.pop()->release();
+
+	entries.insert(0, entry);
+	entry->addRef();
+
+	return entry;
+}
@@ -0,0 +1,106 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef JRD_SIMILAR_TO_CACHE_H
+#define JRD_SIMILAR_TO_CACHE_H
+
+#include "../common/SimilarToRegex.h"
+#include "../common/classes/RefCounted.h"
+#include "../common/classes/locks.h"
+
+namespace Jrd {
+
+class thread_db;
+
+// Recently compiled SIMILAR TO programs of an attachment. Patterns coming from
+// parameters or columns are compiled once and shared by all matchers using them.
+
+class SimilarToCache : public Firebird::PermanentStorage
+{
+	static const FB_SIZE_T MAX_ENTRIES = 32;
+
+public:
+	template <typename Regex>
+	class Entry : public Firebird::RefCounted
+	{
+	public:
+		Entry(MemoryPool& pool, unsigned aFlags,
+				const char* patternStr, unsigned aPatternLen, const char* escapeStr, unsigned escapeLen)
+			: flags(aFlags),
+			  patternLen(aPatternLen),
+			  key(pool),
+			  regex(pool, aFlags, patternStr, aPatternLen, escapeStr, escapeLen)
+		{
+			key.push(reinterpret_cast<const UCHAR*>(patternStr), patternLen);
+			key.push(reinterpret_cast<const UCHAR*>(escapeStr), escapeLen);
+		}
+
+		bool isFor(unsigned aFlags, const char* patternStr, unsigned aPatternLen,
+			const char* escapeStr, unsigned escapeLen) const
+		{
+			return flags == aFlags && patternLen == aPatternLen &&
+				key.getCount() == aPatternLen + escapeLen &&
+				memcmp(key.begin(), patternStr, patternLen) == 0 &&
+				memcmp(key.begin() + patternLen, escapeStr, escapeLen) == 0;
+		}
+
+		Regex* getRegex()
+		{
+			return &regex;
+		}
+
+	private:
+		const unsigned flags;
+		const unsigned patternLen;
+		Firebird::UCharBuffer key;	// pattern followed by escape
+		Regex regex;
+	};
+
+	typedef Entry<Firebird::SimilarToRegex> SimilarEntry;
+	typedef Entry<Firebird::SubstringSimilarRegex> SubstringEntry;
+
+	explicit SimilarToCache(MemoryPool& pool)
+		: PermanentStorage(pool),
+		  similarEntries(pool),
+		  substringEntries(pool)
+	{ }
+
+	~SimilarToCache();
+
+	static Firebird::RefPtr<SimilarEntry> getSimilar(thread_db* tdbb, unsigned flags,
+		const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen);
+
+	static Firebird::RefPtr<SubstringEntry> getSubstring(thread_db* tdbb, unsigned flags,
+		const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen);
+
+private:
+	template <typename E>
+	Firebird::RefPtr<E> get(Firebird::Array<E*>& entries, unsigned flags,
+		const char* patternStr, unsigned patternLen, const char* escapeStr, unsigned escapeLen);
+
+	static SimilarToCache* getCache(thread_db* tdbb);
+
+	Firebird::Mutex mutex;
+	Firebird::Array<SimilarEntry*> similarEntries;		// most recently used first
+	Firebird::Array<SubstringEntry*> substringEntries;
+};
+
+} // namespace Jrd
+
+#endif // JRD_SIMILAR_TO_CACHE_H
@@ -0,0 +1,95 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+#include "firebird.h"
+#include "../jrd/SortKeyCache.h"
+#include "../jrd/jrd.h"
+#include "../jrd/btr.h"
+#include "../jrd/intl.h"
+#include "../jrd/intl_proto.h"
+#include "../common/classes/Hash.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+
+USHORT SortKeyCache::makeKey(thread_db* tdbb, USHORT idxType, const dsc* from, dsc* to, USHORT keyType)
+{
+/**************************************
+ *
+ *	m a k e K e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Same as INTL_string_to_key, reusing the key
+ *	built for the same value recently.
+ *
+ **************************************/
+	const UCHAR* value = NULL;
+	ULONG valueLength = MAX_ULONG;
+
+	if (from->dsc_dtype == dtype_text)
+	{
+		value = from->dsc_address;
+		valueLength = from->dsc_length;
+	}
+	else if (from->dsc_dtype == dtype_varying)
+	{
+		const vary* const string = reinterpret_cast<const vary*>(from->dsc_address);
+		value = reinterpret_cast<const UCHAR*>(string->vary_string);
+		valueLength = string->vary_length;
+	}
+
+	// Keys of the binary collations are plain copies, not worth caching
+
+	if (valueLength > MAX_VALUE_LENGTH || idxType < idx_first_intl_string ||
+		TTYPE_TO_COLLATION(INTL_INDEX_TO_TEXT(idxType)) == 0)
+	{
+		return INTL_string_to_key(tdbb, idxType, from, to, keyType);
+	}
+
+	while (slots.getCount() < SLOTS)
+		slots.add();
+
+	const USHORT textType = from->getTextType();
+	Slot& slot = slots[DefaultHash<UCHAR>::hash(value, valueLength, SLOTS)];
+
+	if (slot.used && slot.idxType == idxType && slot.keyType == keyType &&
+		slot.textType == textType && slot.dstLength == to->dsc_length &&
+		slot.value.getCount() == valueLength && memcmp(slot.value.begin(), value, valueLength) == 0)
+	{
+		memcpy(to->dsc_address, slot.key.begin(), slot.key.getCount());
+		return (USHORT) slot.key.getCount();
+	}
+
+	const USHORT length = INTL_string_to_key(tdbb, idxType, from, to, keyType);
+
+	if (length <= to->dsc_length)
+	{
+		slot.value.assign(value, valueLength);
+		slot.key.assign(to->dsc_address, length);
+		slot.idxType = idxType;
+		slot.keyType = keyType;
+		slot.textType = textType;
+		slot.dstLength = to->dsc_length;
+		slot.used = true;
+	}
+
+	return length;
+}
@@ -0,0 +1,70 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+#ifndef JRD_SORT_KEY_CACHE_H
+#define JRD_SORT_KEY_CACHE_H
+
+#include "../common/classes/objects_array.h"
+#include "../common/dsc.h"
+
+namespace Jrd {
+
+class thread_db;
+
+// Recently built keys of a non-binary collation. Such keys are produced by ICU
+// and cost much more than a lookup, so a sort or an index creation that meets
+// the same value many times builds its key once. The cache belongs to a single
+// consumer and is not thread safe.
+
+class SortKeyCache : public Firebird::PermanentStorage
+{
+	static const FB_SIZE_T SLOTS = 64;
+	static const USHORT MAX_VALUE_LENGTH = 256;
+
+	struct Slot
+	{
+		explicit Slot(MemoryPool& pool)
+			: value(pool),
+			  key(pool),
+			  used(false)
+		{ }
+
+		Firebird::Array<UCHAR> value;
+		Firebird::Array<UCHAR> key;
+		USHORT idxType;
+		USHORT keyType;
+		USHORT textType;
+		USHORT dstLength;
+		bool used;
+	};
+
+public:
+	explicit SortKeyCache(MemoryPool& pool)
+		: PermanentStorage(pool),
+		  slots(pool)
+	{ }
+
+	USHORT makeKey(thread_db* tdbb, USHORT idxType, const dsc* from, dsc* to, USHORT keyType);
+
+private:
+	Firebird::ObjectsArray<Slot> slots;
+};
+
+} // namespace Jrd
+
+#endif // JRD_SORT_KEY_CACHE_H
@@ -123,12 +123,7 @@ Statement::Statement(thread_db* tdbb, MemoryPool* p, CompilerScratch* csb)
 					jrd_rel* relation = resource->rsc_rel;
 					IndexLock* index = CMP_get_index_lock(tdbb, relation, resource->rsc_id);
 					if (index)
-					{
-						++index->idl_count;
-						if (index->idl_count == 1) {
-							LCK_lock(tdbb, index->idl_lock, LCK_SR, LCK_WAIT);
-						}
-					}
+						CMP_post_index_existence(tdbb, index);
 					break;
 				}
 
@@ -690,12 +685,8 @@ void Statement::release(thread_db* tdbb)
 			{
 				jrd_rel* relation = resource->rsc_rel;
 				IndexLock* index = CMP_get_index_lock(tdbb, relation, resource->rsc_id);
-				if (index && index->idl_count)
-				{
-					--index->idl_count;
-					if (!index->idl_count)
-						LCK_release(tdbb, index->idl_lock);
-				}
+				if (index)
+					CMP_release_index_existence(tdbb, index);
 				break;
 			}
 
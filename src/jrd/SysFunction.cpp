@@ -6028,7 +6028,7 @@ dsc* evlPosition(thread_db* tdbb, const SysFunction* function, const NestValueAr
 	else
 		value1Length = MOV_make_string2(tdbb, value1, ttype, &value1Address, value1Buffer);
 
-	HalfStaticArray<UCHAR, BUFFER_SMALL> value1Canonical;
+	ArenaBuffer<BUFFER_SMALL> value1Canonical(request->req_arena);
 	value1Canonical.getBuffer(value1Length / cs->minBytesPerChar() * canonicalWidth);
 	const SLONG value1CanonicalLen = tt->canonical(value1Length, value1Address,
 		value1Canonical.getCount(), value1Canonical.begin()) * canonicalWidth;
@@ -6058,7 +6058,7 @@ dsc* evlPosition(thread_db* tdbb, const SysFunction* function, const NestValueAr
 	else
 		value2Length = MOV_make_string2(tdbb, value2, ttype, &value2Address, value2Buffer);
 
-	HalfStaticArray<UCHAR, BUFFER_SMALL> value2Canonical;
+	ArenaBuffer<BUFFER_SMALL> value2Canonical(request->req_arena);
 	value2Canonical.getBuffer(value2Length / cs->minBytesPerChar() * canonicalWidth);
 	const SLONG value2CanonicalLen = tt->canonical(value2Length, value2Address,
 		value2Canonical.getCount(), value2Canonical.begin()) * canonicalWidth;
@@ -6348,8 +6348,8 @@ dsc* evlReverse(thread_db* tdbb, const SysFunction*, const NestValueArray& args,
 		blb* blob = blb::open(tdbb, tdbb->getRequest()->req_transaction,
 			reinterpret_cast<bid*>(value->dsc_address));
 
-		HalfStaticArray<UCHAR, BUFFER_LARGE> buffer;
-		HalfStaticArray<UCHAR, BUFFER_LARGE> buffer2;
+		ArenaBuffer<BUFFER_LARGE> buffer(request->req_arena);
+		ArenaBuffer<BUFFER_LARGE> buffer2(request->req_arena);
 
 		UCHAR* p = buffer.getBuffer(blob->blb_length);
 		const SLONG len = blob->BLB_get_data(tdbb, p, blob->blb_length, true);
@@ -45,6 +45,7 @@
 #include "../jrd/lck.h"
 #include "../jrd/cch.h"
 #include "../jrd/sort.h"
+#include "../jrd/SortKeyCache.h"
 #include "../jrd/val.h"
 #include "../common/gdsassert.h"
 #include "../jrd/btr_proto.h"
@@ -190,7 +191,7 @@ namespace
 static ULONG add_node(thread_db*, WIN*, index_insertion*, temporary_key*, RecordNumber*,
 					  ULONG*, ULONG*);
 static void compress(thread_db*, const dsc*, const SSHORT scale, temporary_key*,
-					 USHORT, bool, USHORT, bool*);
+					 USHORT, bool, USHORT, bool*, SortKeyCache* = nullptr);
 static USHORT compress_root(thread_db*, index_root_page*);
 static void copy_key(const temporary_key*, temporary_key*);
 static contents delete_node(thread_db*, WIN*, UCHAR*);
@@ -595,7 +596,8 @@ idx_e IndexKey::compose(Record* record)
 
 			m_key.key_flags |= key_empty;
 
-			compress(m_tdbb, desc_ptr, 0, &m_key, tail->idx_itype, descending, m_keyType, nullptr);
+			compress(m_tdbb, desc_ptr, 0, &m_key, tail->idx_itype, descending, m_keyType, nullptr,
+				m_keyCache);
 		}
 		else
 		{
@@ -634,7 +636,8 @@ idx_e IndexKey::compose(Record* record)
 					m_key.key_nulls |= 1 << n;
 				}
 
-				compress(m_tdbb, desc_ptr, 0, &temp, tail->idx_itype, descending, m_keyType, nullptr);
+				compress(m_tdbb, desc_ptr, 0, &temp, tail->idx_itype, descending, m_keyType, nullptr,
+					m_keyCache);
 
 				const UCHAR* q = temp.key_data;
 				for (USHORT l = temp.key_length; l; --l, --stuff_count)
@@ -2773,7 +2776,8 @@ static void compress(thread_db* tdbb,
 					 temporary_key* key,
 					 USHORT itype,
 					 bool descending, USHORT key_type,
-					 bool* forceInclude)
+					 bool* forceInclude,
+					 SortKeyCache* keyCache)
 {
 /**************************************
  *
@@ -2880,7 +2884,9 @@ static void compress(thread_db* tdbb,
 					to.dsc_ttype() = ttype_sort_key;
 					to.dsc_length = MIN(MAX_COLUMN_SIZE, MAX_KEY * 4);
 					ptr = to.dsc_address = reinterpret_cast<UCHAR*>(buffer.vary_string);
-					multiKeyLength = length = INTL_string_to_key(tdbb, itype, desc, &to, key_type);
+					multiKeyLength = length = keyCache ?
+						keyCache->makeKey(tdbb, itype, desc, &to, key_type) :
+						INTL_string_to_key(tdbb, itype, desc, &to, key_type);
 				}
 				else
 					length = MOV_get_string(tdbb, desc, &ptr, &buffer, MAX_KEY);
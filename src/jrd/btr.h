@@ -49,6 +49,7 @@ class thread_db;
 class BtrPageGCLock;
 class Sort;
 class PartitionedSort;
+class SortKeyCache;
 struct sort_key_def;
 
 // Index descriptor block -- used to hold info from index root page
@@ -420,12 +421,19 @@ public:
 
 	IndexKey(const IndexKey& other)
 		: m_tdbb(other.m_tdbb), m_relation(other.m_relation), m_index(other.m_index),
-		  m_keyType(other.m_keyType), m_segments(other.m_segments), m_expression(other.m_expression)
+		  m_keyType(other.m_keyType), m_segments(other.m_segments), m_expression(other.m_expression),
+		  m_keyCache(other.m_keyCache)
 	{
 	}
 
 	idx_e compose(Record* record);
 
+	// Reuse keys of the repeating values of the non-binary collations
+	void setKeyCache(SortKeyCache* keyCache)
+	{
+		m_keyCache = keyCache;
+	}
+
 	operator temporary_key*()
 	{
 		return &m_key;
@@ -477,6 +485,7 @@ private:
 	temporary_key m_key;
 	AutoIndexExpression& m_expression;
 	AutoIndexExpression m_localExpression;
+	SortKeyCache* m_keyCache = nullptr;
 };
 
 // List scan iterator
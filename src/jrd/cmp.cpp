@@ -101,6 +101,9 @@ IMPLEMENT_TRACE_ROUTINE(cmp_trace, "CMP")
 #endif
 
 
+static int blocking_ast_index(void*);
+
+
 // Clone a node.
 ValueExprNode* CMP_clone_node(thread_db* tdbb, CompilerScratch* csb, ValueExprNode* node)
 {
@@ -315,8 +318,10 @@ IndexLock* CMP_get_index_lock(thread_db* tdbb, jrd_rel* relation, USHORT id)
 	index->idl_relation = relation;
 	index->idl_id = id;
 	index->idl_count = 0;
+	index->idl_blocking = false;
 
-	Lock* lock = FB_NEW_RPT(*relation->rel_pool, 0) Lock(tdbb, sizeof(SLONG), LCK_idx_exist);
+	Lock* lock = FB_NEW_RPT(*relation->rel_pool, 0)
+		Lock(tdbb, sizeof(SLONG), LCK_idx_exist, index, blocking_ast_index);
 	index->idl_lock = lock;
 	lock->setKey((relation->rel_id << 16) | id);
 
@@ -324,6 +329,54 @@ IndexLock* CMP_get_index_lock(thread_db* tdbb, jrd_rel* relation, USHORT id)
 }
 
 
+void CMP_post_index_existence(thread_db* tdbb, IndexLock* index)
+{
+/**************************************
+ *
+ *	C M P _ p o s t _ i n d e x _ e x i s t e n c e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Post an interest in the existence of an index.
+ *	The lock may be still granted since the last use,
+ *	then the lock manager is not bothered.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	if (++index->idl_count == 1 && index->idl_lock->lck_logical == LCK_none)
+		LCK_lock(tdbb, index->idl_lock, LCK_SR, LCK_WAIT);
+}
+
+
+void CMP_release_index_existence(thread_db* tdbb, IndexLock* index)
+{
+/**************************************
+ *
+ *	C M P _ r e l e a s e _ i n d e x _ e x i s t e n c e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Release an interest in the existence of an index.
+ *	The lock is kept granted for the next user unless
+ *	someone is waiting to drop the index.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	if (!index->idl_count)
+		return;
+
+	if (!--index->idl_count && index->idl_blocking)
+	{
+		index->idl_blocking = false;
+		LCK_release(tdbb, index->idl_lock);
+	}
+}
+
+
 void CMP_post_access(thread_db* tdbb,
 					 CompilerScratch* csb,
 					 const MetaName& security_name,
@@ -712,3 +765,40 @@ RecordSource* CMP_post_rse(thread_db* tdbb, CompilerScratch* csb, RseNode* rse)
 
 	return rsb;
 }
+
+
+static int blocking_ast_index(void* ast_object)
+{
+/**************************************
+ *
+ *	b l o c k i n g _ a s t _ i n d e x
+ *
+ **************************************
+ *
+ * Functional description
+ *	Someone is trying to drop an index. If there are
+ *	outstanding interests in its existence then just mark
+ *	the lock as blocking, otherwise release it.
+ *
+ **************************************/
+	IndexLock* const index = static_cast<IndexLock*>(ast_object);
+
+	try
+	{
+		Database* const dbb = index->idl_lock->lck_dbb;
+
+		AsyncContextHolder tdbb(dbb, FB_FUNCTION, index->idl_lock);
+
+		if (index->idl_count)
+			index->idl_blocking = true;
+		else
+		{
+			index->idl_blocking = false;
+			LCK_release(tdbb, index->idl_lock);
+		}
+	}
+	catch (const Exception&)
+	{} // no-op
+
+	return 0;
+}
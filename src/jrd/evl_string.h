@@ -30,6 +30,7 @@
 
 #include "../common/classes/alloc.h"
 #include "../common/classes/array.h"
+#include "../common/StringSearch.h"
 
 // Number of pattern items statically allocated
 const int STATIC_PATTERN_ITEMS	= 16;
@@ -191,6 +192,30 @@ public:
 		if (result)
 			return false;
 
+		// Short chunks are not worth the effort
+		if (data_len < pattern_len * 2)
+			return kmpSearch(data, data_len);
+
+		// Match started in the previous chunk ends in its first characters
+		const SLONG tail_len = pattern_len - 1;
+
+		if (offset > 0 && !kmpSearch(data, tail_len))
+			return false;
+
+		if (StringSearch::find(data, data_len, pattern_str, pattern_len))
+		{
+			result = true;
+			return false;
+		}
+
+		// Remember the partial match at the end of chunk
+		offset = 0;
+		return kmpSearch(data + data_len - tail_len, tail_len);
+	}
+
+private:
+	bool kmpSearch(const CharType* data, SLONG data_len)
+	{
 		SLONG data_pos = 0;
 		while (data_pos < data_len)
 		{
@@ -206,7 +231,6 @@ public:
 		return true;
 	}
 
-private:
 	const CharType* pattern_str;
 	SLONG pattern_len;
 	SLONG offset;
@@ -500,6 +524,17 @@ bool LikeEvaluator<CharType>::processNextChunk(const CharType* data, SLONG data_
 
 	while (data_pos < data_len)
 	{
+		// Searching for the first subpattern, skip right to its first character
+		if (branches.getCount() == 1 && branches[0].offset == 0 &&
+			branches[0].pattern->type == piSearch)
+		{
+			data_pos = StringSearch::findChar(data + data_pos, data + data_len,
+				branches[0].pattern->str.data[0]) - data;
+
+			if (data_pos >= data_len)
+				break;
+		}
+
 		FB_SIZE_T branch_number = 0;
 		while (branch_number < branches.getCount())
 		{
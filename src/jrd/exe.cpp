@@ -71,6 +71,7 @@
 #include "../jrd/intl.h"
 #include "../jrd/sbm.h"
 #include "../jrd/blb.h"
+#include "../jrd/IndexKeyBatch.h"
 #include "../jrd/SystemTriggers.h"
 #include "firebird/impl/blr.h"
 #include "../dsql/ExprNodes.h"
@@ -1002,6 +1003,8 @@ static void activate_request(thread_db* tdbb, Request* request, jrd_tra* transac
 
 	request->req_profiler_ticks = 0;
 
+	request->req_arena.reset();
+
 	// Store request start time for timestamp work
 	request->validateTimeStamp();
 
@@ -1246,6 +1249,7 @@ void EXE_unwind(thread_db* tdbb, Request* request)
 	}
 
 	request->req_sorts.unlinkAll();
+	request->req_arena.reset();
 
 	TRA_release_request_snapshot(tdbb, request);
 	TRA_detach_request(request);
@@ -1295,9 +1299,19 @@ static void execute_looper(thread_db* tdbb,
 	try
 	{
 		looper_seh(tdbb, request, node);
+
+		// Load index keys deferred by the bulk insert while our savepoint is still alive
+
+		if (request->req_index_keys)
+			request->req_index_keys->flush(tdbb, transaction);
 	}
 	catch (const Exception&)
 	{
+		// Keys of the records being undone are not needed anymore
+
+		if (request->req_index_keys)
+			request->req_index_keys->clear();
+
 		// In the case of error, undo changes performed under our savepoint
 
 		if (savNumber)
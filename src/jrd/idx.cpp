@@ -46,6 +46,8 @@
 #include "../jrd/scl.h"
 #include "../jrd/lck.h"
 #include "../jrd/cch.h"
+#include "../jrd/IndexKeyBatch.h"
+#include "../jrd/SortKeyCache.h"
 #include "../common/gdsassert.h"
 #include "../jrd/btr_proto.h"
 #include "../jrd/cch_proto.h"
@@ -578,7 +580,9 @@ bool IndexCreateTask::handler(WorkItem& _item)
 	lastRecNo.compose(dbb->dbb_max_records, dbb->dbb_dp_per_pp, 0, 0, item->m_ppSequence + 1);
 	lastRecNo.decrement();
 
+	SortKeyCache keyCache(*tdbb->getDefaultPool());
 	IndexKey key(tdbb, relation, idx);
+	key.setKeyCache(&keyCache);
 	IndexCondition condition(tdbb, idx);
 
 	// Loop thru the relation computing index keys.  If there are old versions, find them, too.
@@ -971,11 +975,7 @@ void IDX_create_index(thread_db* tdbb,
 	{
 		IndexLock* idx_lock = CMP_get_index_lock(tdbb, relation, idx->idx_id);
 		if (idx_lock)
-		{
-			++idx_lock->idl_count;
-			if (idx_lock->idl_count == 1)
-				LCK_lock(tdbb, idx_lock->idl_lock, LCK_SR, LCK_WAIT);
-		}
+			CMP_post_index_existence(tdbb, idx_lock);
 	}
 }
 
@@ -1511,7 +1511,7 @@ void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityLi
 }
 
 
-void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
+void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction, IndexKeyBatch* batch)
 {
 /**************************************
  *
@@ -1524,9 +1524,17 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
  *	index is violated, return the index number.  If successful, return
  *	-1.
  *
+ *	If the batch is passed, keys of the indices that need no checks
+ *	(i.e. not unique and not foreign ones) are collected there to be
+ *	inserted later on, in key order. Flushing a full batch is up to
+ *	the caller.
+ *
  **************************************/
 	SET_TDBB(tdbb);
 
+	if (batch && !batch->accepts(rpb->rpb_relation))
+		batch->flush(tdbb, transaction);
+
 	index_desc idx;
 	idx.idx_id = idx_invalid;
 
@@ -1571,6 +1579,12 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 
 		expression.reset();
 
+		if (batch && !(idx.idx_flags & (idx_unique | idx_primary | idx_foreign | idx_in_progress)))
+		{
+			batch->add(rpb->rpb_relation, idx.idx_id, rpb->rpb_number, key);
+			continue;
+		}
+
 		insertion.iib_key = key;
 
 		if ( (error_code = insert_key(tdbb, rpb->rpb_relation, rpb->rpb_record, transaction,
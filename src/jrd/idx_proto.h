@@ -34,6 +34,7 @@ namespace Jrd
 	class jrd_tra;
 	struct record_param;
 	class IndexBlock;
+	class IndexKeyBatch;
 	struct index_desc;
 	class CompilerScratch;
 	class thread_db;
@@ -51,7 +52,7 @@ void IDX_garbage_collect(Jrd::thread_db*, Jrd::record_param*, Jrd::RecordStack&,
 void IDX_modify(Jrd::thread_db*, Jrd::record_param*, Jrd::record_param*, Jrd::jrd_tra*);
 void IDX_modify_check_constraints(Jrd::thread_db*, Jrd::record_param*, Jrd::record_param*, Jrd::jrd_tra*);
 void IDX_statistics(Jrd::thread_db*, Jrd::jrd_rel*, USHORT, Jrd::SelectivityList&);
-void IDX_store(Jrd::thread_db*, Jrd::record_param*, Jrd::jrd_tra*);
+void IDX_store(Jrd::thread_db*, Jrd::record_param*, Jrd::jrd_tra*, Jrd::IndexKeyBatch* = NULL);
 void IDX_modify_flag_uk_modified(Jrd::thread_db*, Jrd::record_param*, Jrd::record_param*, Jrd::jrd_tra*);
 
 
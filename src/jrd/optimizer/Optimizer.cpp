@@ -2858,6 +2858,18 @@ RecordSource* Optimizer::generateRetrieval(StreamType stream,
 		{
 			rsb = FB_NEW_POOL(getPool()) BitmapTableScan(csb, alias, stream, relation,
 				inversion, scanSelectivity);
+
+			// Allow to fall back to the full scan for the parameter values
+			// making the index scan to fetch the most of the table
+
+			if (tdbb->getDatabase()->dbb_config->getParameterSensitivePlans() &&
+				AdaptiveStream::isParameterSensitive(inversion))
+			{
+				RecordSource* const rsb1 =
+					FB_NEW_POOL(getPool()) FullTableScan(csb, alias, stream, relation, dbkeyRanges);
+
+				rsb = FB_NEW_POOL(getPool()) AdaptiveStream(csb, rsb1, rsb, inversion);
+			}
 		}
 		else
 		{
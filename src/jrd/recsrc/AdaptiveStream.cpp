@@ -0,0 +1,364 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird development team
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../jrd/jrd.h"
+#include "../jrd/btr.h"
+#include "../jrd/req.h"
+#include "../dsql/ExprNodes.h"
+#include "../jrd/cmp_proto.h"
+#include "../jrd/evl_proto.h"
+
+#include "RecordSource.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+namespace
+{
+	// Part of the table fetched by an index scan that makes the full scan preferred
+	const double FULL_SCAN_RATIO = 0.3;
+
+	const FB_UINT64 CHOICE_VALID = 1;
+	const FB_UINT64 CHOICE_FULL_SCAN = 2;
+
+	const FB_UINT64 HASH_OFFSET = FB_CONST64(14695981039346656037U);
+	const FB_UINT64 HASH_PRIME = FB_CONST64(1099511628211U);
+
+	FB_UINT64 hashBytes(FB_UINT64 hash, const UCHAR* data, ULONG length)
+	{
+		for (const UCHAR* const end = data + length; data < end; ++data)
+			hash = (hash ^ *data) * HASH_PRIME;
+
+		return hash;
+	}
+
+	template <typename T>
+	bool collectValues(const InversionNode* node, T& values)
+	{
+		switch (node->type)
+		{
+			case InversionNode::TYPE_AND:
+			case InversionNode::TYPE_OR:
+				return collectValues(node->node1, values) && collectValues(node->node2, values);
+
+			case InversionNode::TYPE_INDEX:
+				break;
+
+			default:
+				return false;
+		}
+
+		const IndexRetrieval* const retrieval = node->retrieval;
+
+		// Unique matches and lists are cheap enough whatever the values are
+		if (retrieval->irb_list || (retrieval->irb_generic & irb_unique))
+			return false;
+
+		const auto checkValue = [&values](const ValueExprNode* value)
+		{
+			if (!value || nodeIs<LiteralNode>(value))
+				return true;
+
+			if (!nodeIs<ParameterNode>(value) && !nodeIs<VariableNode>(value))
+				return false;
+
+			if (!values.exist(value))
+				values.add(value);
+
+			return true;
+		};
+
+		for (USHORT i = 0; i < retrieval->irb_lower_count; i++)
+		{
+			if (!checkValue(retrieval->irb_value[i]))
+				return false;
+		}
+
+		const ValueExprNode* const* const upper = retrieval->irb_value + retrieval->irb_desc.idx_count;
+
+		for (USHORT i = 0; i < retrieval->irb_upper_count; i++)
+		{
+			if (!checkValue(upper[i]))
+				return false;
+		}
+
+		return true;
+	}
+}
+
+// ---------------------------------------------------------
+// Data access: full or index scan chosen by parameter values
+// ---------------------------------------------------------
+
+AdaptiveStream::AdaptiveStream(CompilerScratch* csb,
+							   RecordSource* first, RecordSource* second,
+							   InversionNode* inversion)
+	: RecordSource(csb),
+	  m_first(first),
+	  m_second(second),
+	  m_values(csb->csb_pool),
+	  m_nextChoice(0),
+	  m_fullScans(0),
+	  m_indexScans(0)
+{
+	fb_assert(m_first && m_second && inversion);
+
+	collectValues(inversion, m_values);
+	fb_assert(m_values.hasData());
+
+	for (auto& choice : m_choices)
+		choice.store(0, std::memory_order_relaxed);
+
+	m_impure = csb->allocImpure<Impure>();
+	m_cardinality = second->getCardinality();
+	m_threshold = (FB_UINT64) (first->getCardinality() * FULL_SCAN_RATIO) + 1;
+}
+
+bool AdaptiveStream::isParameterSensitive(const InversionNode* inversion)
+{
+	HalfStaticArray<const ValueExprNode*, 8> values;
+	return collectValues(inversion, values) && values.hasData();
+}
+
+FB_UINT64 AdaptiveStream::makeKey(thread_db* tdbb, Request* request) const
+{
+/**************************************
+ *
+ *	m a k e K e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Hash the current values of the index bounds.
+ *	Two lower bits are reserved for the choice flags.
+ *
+ **************************************/
+	FB_UINT64 hash = HASH_OFFSET;
+
+	for (const auto value : m_values)
+	{
+		const dsc* const desc = EVL_expr(tdbb, request, value);
+
+		if (!desc)
+		{
+			hash = (hash ^ 0xFF) * HASH_PRIME;
+			continue;
+		}
+
+		const UCHAR dtype = desc->dsc_dtype;
+		hash = hashBytes(hash, &dtype, sizeof(dtype));
+
+		ULONG length = desc->dsc_length;
+
+		if (desc->dsc_dtype == dtype_varying)
+			length = MIN(length, reinterpret_cast<const vary*>(desc->dsc_address)->vary_length + sizeof(USHORT));
+		else if (desc->dsc_dtype == dtype_cstring)
+			length = MIN(length, strlen(reinterpret_cast<const char*>(desc->dsc_address)));
+
+		hash = hashBytes(hash, desc->dsc_address, length);
+	}
+
+	return (hash & ~(CHOICE_VALID | CHOICE_FULL_SCAN)) | CHOICE_VALID;
+}
+
+void AdaptiveStream::setChoice(FB_UINT64 key, bool fullScan) const
+{
+	const FB_UINT64 choice = key | (fullScan ? CHOICE_FULL_SCAN : 0);
+
+	for (auto& entry : m_choices)
+	{
+		if ((entry.load(std::memory_order_relaxed) & ~CHOICE_FULL_SCAN) == key)
+		{
+			entry.store(choice, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	const unsigned slot = m_nextChoice.fetch_add(1, std::memory_order_relaxed) % CHOICE_CACHE_SIZE;
+	m_choices[slot].store(choice, std::memory_order_relaxed);
+}
+
+void AdaptiveStream::internalOpen(thread_db* tdbb) const
+{
+	Request* const request = tdbb->getRequest();
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	impure->irsb_key = makeKey(tdbb, request);
+	impure->irsb_fetched = 0;
+	impure->irsb_next = m_second;
+
+	for (const auto& entry : m_choices)
+	{
+		const FB_UINT64 choice = entry.load(std::memory_order_relaxed);
+
+		if ((choice & ~CHOICE_FULL_SCAN) == impure->irsb_key)
+		{
+			// Values are known, there is nothing to learn
+			impure->irsb_key = 0;
+
+			if (choice & CHOICE_FULL_SCAN)
+				impure->irsb_next = m_first;
+
+			break;
+		}
+	}
+
+	if (impure->irsb_next == m_first)
+		++m_fullScans;
+	else
+		++m_indexScans;
+
+	impure->irsb_flags = irsb_open;
+	impure->irsb_next->open(tdbb);
+}
+
+void AdaptiveStream::close(thread_db* tdbb) const
+{
+	Request* const request = tdbb->getRequest();
+
+	invalidateRecords(request);
+
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	if (impure->irsb_flags & irsb_open)
+	{
+		impure->irsb_flags &= ~irsb_open;
+
+		if (impure->irsb_next)
+			impure->irsb_next->close(tdbb);
+	}
+}
+
+bool AdaptiveStream::internalGetRecord(thread_db* tdbb) const
+{
+	JRD_reschedule(tdbb);
+
+	Request* const request = tdbb->getRequest();
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	if (!(impure->irsb_flags & irsb_open))
+		return false;
+
+	const bool result = impure->irsb_next->getRecord(tdbb);
+
+	// Learn the choice for new values: the full scan is preferred
+	// if the index scan fetches too much, the index scan otherwise
+
+	if (impure->irsb_key)
+	{
+		if (!result)
+		{
+			setChoice(impure->irsb_key, false);
+			impure->irsb_key = 0;
+		}
+		else if (++impure->irsb_fetched >= m_threshold)
+		{
+			setChoice(impure->irsb_key, true);
+			impure->irsb_key = 0;
+		}
+	}
+
+	return result;
+}
+
+bool AdaptiveStream::refetchRecord(thread_db* tdbb) const
+{
+	Request* const request = tdbb->getRequest();
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	if (!(impure->irsb_flags & irsb_open))
+		return false;
+
+	return impure->irsb_next->refetchRecord(tdbb);
+}
+
+WriteLockResult AdaptiveStream::lockRecord(thread_db* tdbb) const
+{
+	Request* const request = tdbb->getRequest();
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	if (!(impure->irsb_flags & irsb_open))
+		return WriteLockResult::CONFLICTED;
+
+	return impure->irsb_next->lockRecord(tdbb);
+}
+
+void AdaptiveStream::getLegacyPlan(thread_db* tdbb, string& plan, unsigned level) const
+{
+	if (!level)
+		plan += "(";
+
+	m_first->getLegacyPlan(tdbb, plan, level + 1);
+
+	plan += ", ";
+
+	m_second->getLegacyPlan(tdbb, plan, level + 1);
+
+	if (!level)
+		plan += ")";
+}
+
+void AdaptiveStream::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned level, bool recurse) const
+{
+	planEntry.className = "AdaptiveStream";
+
+	string text;
+	text.printf("Parameter Sensitive Choice (full scans: %" UQUADFORMAT ", index scans: %" UQUADFORMAT ")",
+		(FB_UINT64) m_fullScans, (FB_UINT64) m_indexScans);
+
+	planEntry.lines.add().text = text;
+	printOptInfo(planEntry.lines);
+
+	if (recurse)
+	{
+		++level;
+		m_first->getPlan(tdbb, planEntry.children.add(), level, recurse);
+		m_second->getPlan(tdbb, planEntry.children.add(), level, recurse);
+	}
+}
+
+void AdaptiveStream::markRecursive()
+{
+	m_first->markRecursive();
+	m_second->markRecursive();
+}
+
+void AdaptiveStream::findUsedStreams(StreamList& streams, bool expandAll) const
+{
+	m_first->findUsedStreams(streams, expandAll);
+	m_second->findUsedStreams(streams, expandAll);
+}
+
+bool AdaptiveStream::isDependent(const StreamList& streams) const
+{
+	return m_first->isDependent(streams) || m_second->isDependent(streams);
+}
+
+void AdaptiveStream::invalidateRecords(Request* request) const
+{
+	m_first->invalidateRecords(request);
+	m_second->invalidateRecords(request);
+}
+
+void AdaptiveStream::nullRecords(thread_db* tdbb) const
+{
+	m_first->nullRecords(tdbb);
+	m_second->nullRecords(tdbb);
+}
@@ -23,6 +23,7 @@
 #ifndef JRD_RECORD_SOURCE_H
 #define JRD_RECORD_SOURCE_H
 
+#include <atomic>
 #include <optional>
 #include "../common/classes/array.h"
 #include "../common/classes/objects_array.h"
@@ -1499,6 +1500,58 @@ namespace Jrd
 		NestConst<BoolExprNode> const m_boolean;
 	};
 
+	class AdaptiveStream : public RecordSource
+	{
+		static const unsigned CHOICE_CACHE_SIZE = 8;
+
+		struct Impure : public RecordSource::Impure
+		{
+			const RecordSource* irsb_next;
+			FB_UINT64 irsb_key;
+			FB_UINT64 irsb_fetched;
+		};
+
+	public:
+		AdaptiveStream(CompilerScratch* csb, RecordSource* first, RecordSource* second,
+					   InversionNode* inversion);
+
+		static bool isParameterSensitive(const InversionNode* inversion);
+
+		void close(thread_db* tdbb) const override;
+
+		bool refetchRecord(thread_db* tdbb) const override;
+		WriteLockResult lockRecord(thread_db* tdbb) const override;
+
+		void getLegacyPlan(thread_db* tdbb, Firebird::string& plan, unsigned level) const override;
+
+		void markRecursive() override;
+		void invalidateRecords(Request* request) const override;
+
+		void findUsedStreams(StreamList& streams, bool expandAll = false) const override;
+		bool isDependent(const StreamList& streams) const override;
+		void nullRecords(thread_db* tdbb) const override;
+
+	protected:
+		void internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned level, bool recurse) const override;
+		void internalOpen(thread_db* tdbb) const override;
+		bool internalGetRecord(thread_db* tdbb) const override;
+
+	private:
+		FB_UINT64 makeKey(thread_db* tdbb, Request* request) const;
+		void setChoice(FB_UINT64 key, bool fullScan) const;
+
+		NestConst<RecordSource> m_first;	// full table scan
+		NestConst<RecordSource> m_second;	// index driven scan
+		Firebird::Array<const ValueExprNode*> m_values;
+		FB_UINT64 m_threshold;
+
+		// Choices made for the recently seen bound values, shared by the requests
+		mutable std::atomic<FB_UINT64> m_choices[CHOICE_CACHE_SIZE];
+		mutable std::atomic<unsigned> m_nextChoice;
+		mutable std::atomic<FB_UINT64> m_fullScans;
+		mutable std::atomic<FB_UINT64> m_indexScans;
+	};
+
 	class TableValueFunctionScan : public RecordStream
 	{
 	protected:
@@ -22,6 +22,7 @@
 #include "../jrd/btr.h"
 #include "../jrd/intl.h"
 #include "../jrd/req.h"
+#include "../jrd/SortKeyCache.h"
 #include "../jrd/tra.h"
 #include "../dsql/ExprNodes.h"
 #include "../jrd/cch_proto.h"
@@ -205,6 +206,7 @@ Sort* SortedStream::init(thread_db* tdbb) const
 	// mapping is done in get_sort().
 
 	dsc to, temp;
+	SortKeyCache keyCache(*tdbb->getDefaultPool());
 
 	while (m_next->getRecord(tdbb))
 	{
@@ -273,7 +275,7 @@ Sort* SortedStream::init(thread_db* tdbb) const
 
 				if (IS_INTL_DATA(&item->desc) && isKey(&item->desc))
 				{
-					INTL_string_to_key(tdbb, INTL_INDEX_TYPE(&item->desc), from, &to,
+					keyCache.makeKey(tdbb, INTL_INDEX_TYPE(&item->desc), from, &to,
 						(m_map->flags & FLAG_UNIQUE ? INTL_KEY_UNIQUE : INTL_KEY_SORT));
 				}
 				else
@@ -34,6 +34,7 @@
 #include "../jrd/Statement.h"
 #include "../jrd/Record.h"
 #include "../jrd/RecordNumber.h"
+#include "../jrd/RequestArena.h"
 #include "../common/classes/timestamp.h"
 #include "../common/TimeZoneUtil.h"
 
@@ -50,6 +51,7 @@ class ValueListNode;
 class jrd_tra;
 class Savepoint;
 class Cursor;
+class IndexKeyBatch;
 class thread_db;
 
 // record parameter block
@@ -334,7 +336,10 @@ public:
 		  req_auto_trans(*req_pool),
 		  req_sorts(*req_pool, attachment->att_database),
 		  req_rpb(*req_pool),
-		  impureArea(*req_pool)
+		  impureArea(*req_pool),
+		  req_index_keys(NULL),
+		  req_batch_keys(NULL),
+		  req_arena(*req_pool)
 	{
 		fb_assert(statement);
 		setAttachment(attachment);
@@ -458,6 +463,9 @@ public:
 	SnapshotData req_snapshot;
 	StatusXcp req_last_xcp;			// last known exception
 	bool req_batch_mode;
+	IndexKeyBatch* req_index_keys;	// deferred index keys of the bulk insert
+	IndexKeyBatch* req_batch_keys;	// index keys deferred until the batch loads them
+	RequestArena req_arena;			// temporaries of node evaluation
 
 	enum req_s {
 		req_evaluate,
@@ -574,6 +582,7 @@ public:
 	jrd_rel*	idl_relation;	// Parent relation
 	USHORT		idl_id;			// Index id
 	USHORT		idl_count;		// Use count
+	bool		idl_blocking;	// Someone waits for the lock to be released
 };
 
 } //namespace Jrd
@@ -0,0 +1,89 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/StatusArg.h"
+#include "../jrd/evl_string.h"
+#include <string>
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(EvlStringSuite)
+
+
+BOOST_AUTO_TEST_SUITE(EvlStringTests)
+
+// Feed the data by chunks of the given length
+template <typename Evaluator>
+static bool evaluate(Evaluator& evaluator, const std::string& data, size_t chunk)
+{
+	evaluator.reset();
+
+	for (size_t pos = 0; pos < data.length(); pos += chunk)
+	{
+		const size_t len = std::min(chunk, data.length() - pos);
+
+		if (!evaluator.processNextChunk(reinterpret_cast<const UCHAR*>(data.data() + pos), (SLONG) len))
+			break;
+	}
+
+	return evaluator.getResult();
+}
+
+BOOST_AUTO_TEST_CASE(ContainsChunksTest)
+{
+	const std::string data =
+		"abababcabababcabababababcaaabbbababcababcabcababcabababababababcab"
+		"xyzzy xyzzz xyzzy xyzzy yzzyx abababababababababababababababababcd";
+
+	const char* const patterns[] = {
+		"a", "ab", "abc", "ababc", "abababc", "ababababababc", "cabababababababcab",
+		"xyzzz", "yzzyx", "zzz", "abcd", "abce", "ababababababababababababababababababcd", "q"
+	};
+
+	for (const char* pattern : patterns)
+	{
+		ContainsEvaluator<UCHAR> evaluator(*getDefaultMemoryPool(),
+			reinterpret_cast<const UCHAR*>(pattern), (SLONG) strlen(pattern));
+
+		const bool expected = data.find(pattern) != std::string::npos;
+
+		for (size_t chunk = 1; chunk <= data.length(); ++chunk)
+			BOOST_TEST(evaluate(evaluator, data, chunk) == expected, pattern << " by " << chunk);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(LikeChunksTest)
+{
+	const std::string data = "xxabcxxabdxxxabcabd_end";
+
+	const struct
+	{
+		const char* pattern;
+		bool result;
+	} tests[] = {
+		{"%abd%", true},
+		{"%abd", false},
+		{"%_end", true},
+		{"%abc_abd%", false},
+		{"%abcabd%end", true},
+		{"%ab_xx%", true},
+		{"%abe%", false},
+		{"xx%abd%", true}
+	};
+
+	for (const auto& test : tests)
+	{
+		LikeEvaluator<UCHAR> evaluator(*getDefaultMemoryPool(),
+			reinterpret_cast<const UCHAR*>(test.pattern), (SLONG) strlen(test.pattern),
+			'\\', true, '%', '_');
+
+		for (size_t chunk = 1; chunk <= data.length(); ++chunk)
+			BOOST_TEST(evaluate(evaluator, data, chunk) == test.result, test.pattern << " by " << chunk);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// EvlStringTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// EvlStringSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
@@ -0,0 +1,87 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/RequestArena.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(RequestArenaSuite)
+
+
+BOOST_AUTO_TEST_SUITE(RequestArenaTests)
+
+BOOST_AUTO_TEST_CASE(ScopeReuseTest)
+{
+	RequestArena arena(*getDefaultMemoryPool());
+
+	UCHAR* first = NULL;
+
+	for (unsigned i = 0; i < 1000; ++i)
+	{
+		RequestArena::Scope scope(arena);
+
+		UCHAR* const p1 = scope.allocate(100);
+		UCHAR* const p2 = scope.allocate(1000);
+		BOOST_TEST(p2 >= p1 + 100);
+
+		memset(p1, 1, 100);
+		memset(p2, 2, 1000);
+
+		// Memory released by the scope is reused
+		if (!first)
+			first = p1;
+		BOOST_TEST(p1 == first);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(LargeAllocationTest)
+{
+	RequestArena arena(*getDefaultMemoryPool());
+
+	{
+		RequestArena::Scope scope(arena);
+		memset(scope.allocate(100000), 0, 100000);
+	}
+
+	BOOST_TEST(!arena.getMark().chunk);
+
+	// Oversized chunk is returned to the pool, small allocations use a standard one
+	{
+		RequestArena::Scope scope(arena);
+		memset(scope.allocate(100), 0, 100);
+		BOOST_TEST(arena.getMark().chunk);
+	}
+
+	arena.reset();
+	BOOST_TEST(!arena.getMark().chunk);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaBufferTest)
+{
+	RequestArena arena(*getDefaultMemoryPool());
+
+	{
+		ArenaBuffer<16> buffer(arena);
+
+		memcpy(buffer.getBuffer(10), "0123456789", 10);
+		BOOST_TEST(buffer.getCount() == 10u);
+		BOOST_TEST(buffer.getCapacity() == 16u);
+		BOOST_TEST(!arena.getMark().chunk);
+
+		// Growing the buffer preserves its contents
+		UCHAR* const p = buffer.getBuffer(1000);
+		BOOST_TEST(memcmp(p, "0123456789", 10) == 0);
+		BOOST_TEST(buffer.getCapacity() == 1000u);
+		BOOST_TEST(arena.getMark().used >= 1000u);
+	}
+
+	const RequestArena::Mark mark = arena.getMark();
+	BOOST_TEST(mark.used == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// RequestArenaTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// RequestArenaSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
@@ -0,0 +1,98 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../dsql/StmtNodes.h"
+#include "../dsql/BoolNodes.h"
+#include "../dsql/ExprNodes.h"
+#include "../jrd/RecordSourceNodes.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(StoreValidationSuite)
+
+
+namespace
+{
+	const StreamType STORED_STREAM = 0;
+	const StreamType OTHER_STREAM = 1;
+
+	// NOT NULL check of a field, e.g. of a primary key column
+	BoolExprNode* makeNotNull(MemoryPool& pool, USHORT fieldId)
+	{
+		FieldNode* const field = FB_NEW_POOL(pool) FieldNode(pool, STORED_STREAM, fieldId, true);
+		return FB_NEW_POOL(pool) NotBoolNode(pool, FB_NEW_POOL(pool) MissingBoolNode(pool, field));
+	}
+
+	// Domain CHECK (VALUE IS NULL OR (SELECT COUNT(*) FROM <relation of subStream>) > VALUE)
+	BoolExprNode* makeSubQueryCheck(MemoryPool& pool, USHORT fieldId, StreamType subStream)
+	{
+		RelationSourceNode* const relSource = FB_NEW_POOL(pool) RelationSourceNode(pool);
+		relSource->setStream(subStream);
+
+		RseNode* const rse = FB_NEW_POOL(pool) RseNode(pool);
+		rse->rse_relations.add(relSource);
+
+		SubQueryNode* const subQuery = FB_NEW_POOL(pool) SubQueryNode(pool, blr_count);
+		subQuery->rse = rse;
+
+		FieldNode* const field = FB_NEW_POOL(pool) FieldNode(pool, STORED_STREAM, fieldId, true);
+
+		return FB_NEW_POOL(pool) BinaryBoolNode(pool, blr_or,
+			FB_NEW_POOL(pool) MissingBoolNode(pool, field),
+			FB_NEW_POOL(pool) ComparativeBoolNode(pool, blr_gtr, subQuery,
+				FB_NEW_POOL(pool) FieldNode(pool, STORED_STREAM, fieldId, true)));
+	}
+
+	void addValidation(MemoryPool& pool, Array<ValidateInfo>& validations, BoolExprNode* boolean,
+		USHORT fieldId)
+	{
+		ValidateInfo validate;
+		validate.boolean = boolean;
+		validate.value = FB_NEW_POOL(pool) FieldNode(pool, STORED_STREAM, fieldId, true);
+		validations.add(validate);
+	}
+}
+
+
+BOOST_AUTO_TEST_SUITE(StoreValidationTests)
+
+BOOST_AUTO_TEST_CASE(NoValidationsTest)
+{
+	AutoMemoryPool pool(MemoryPool::createPool());
+	Array<ValidateInfo> validations(*pool);
+
+	BOOST_TEST(!StoreNode::validationsReadStreams(validations, STORED_STREAM));
+}
+
+BOOST_AUTO_TEST_CASE(PrimaryKeyTableTest)
+{
+	// Primary key columns are NOT NULL, that must not prevent deferring index keys
+
+	AutoMemoryPool pool(MemoryPool::createPool());
+	Array<ValidateInfo> validations(*pool);
+
+	addValidation(*pool, validations, makeNotNull(*pool, 0), 0);
+	addValidation(*pool, validations, makeNotNull(*pool, 2), 2);
+
+	BOOST_TEST(!StoreNode::validationsReadStreams(validations, STORED_STREAM));
+}
+
+BOOST_AUTO_TEST_CASE(SubQueryCheckTest)
+{
+	// A domain CHECK with a sub-query could look for the stored records
+
+	AutoMemoryPool pool(MemoryPool::createPool());
+	Array<ValidateInfo> validations(*pool);
+
+	addValidation(*pool, validations, makeNotNull(*pool, 0), 0);
+	addValidation(*pool, validations, makeSubQueryCheck(*pool, 1, OTHER_STREAM), 1);
+
+	BOOST_TEST(StoreNode::validationsReadStreams(validations, STORED_STREAM));
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// StoreValidationTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// StoreValidationSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
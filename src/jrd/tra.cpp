@@ -1382,6 +1382,9 @@ void TRA_rollback(thread_db* tdbb, jrd_tra* transaction, const bool retaining_fl
  **************************************/
 	SET_TDBB(tdbb);
 
+	// Changes of the transaction are gone, even if not undone one by one
+	transaction->tra_attachment->att_data_changes++;
+
 	TraceTransactionEnd trace(transaction, false, retaining_flag);
 
 	EDS::Transaction::jrdTransactionEnd(tdbb, transaction, false, retaining_flag, false /*force_flag ?*/);
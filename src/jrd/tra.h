@@ -194,6 +194,7 @@ public:
 		tra_blob_space(NULL),
 		tra_undo_space(NULL),
 		tra_undo_records(*p),
+		tra_undo_buffer(*p),
 		tra_timezone_snapshot(NULL),
 		tra_user_management(NULL),
 		tra_sec_db_context(NULL),
@@ -315,6 +316,7 @@ private:
 	TempSpace* tra_undo_space;	// undo log storage
 
 	UndoRecordList tra_undo_records;	// temporary records used for the undo purposes
+	Firebird::UCharBuffer tra_undo_buffer;	// scratch buffer to (un)pack undo records
 	TimeZoneSnapshot* tra_timezone_snapshot;
 	UserManagement* tra_user_management;
 	SecDbContext* tra_sec_db_context;
@@ -358,6 +360,11 @@ public:
 		return tra_undo_space;
 	}
 
+	UCHAR* getUndoBuffer(FB_SIZE_T length)
+	{
+		return tra_undo_buffer.getBuffer(length);
+	}
+
 	Record* getUndoRecord(const Format* format)
 	{
 		for (Record** iter = tra_undo_records.begin(); iter != tra_undo_records.end(); ++iter)
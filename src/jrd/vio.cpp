@@ -173,6 +173,7 @@ static void protect_system_table_insert(thread_db* tdbb, const Request* req, con
 static void protect_system_table_delupd(thread_db* tdbb, const jrd_rel* relation, const char* operation,
 	bool force_flag = false);
 static void purge(thread_db*, record_param*);
+static void purge_before_update(thread_db*, jrd_tra*, record_param*);
 static void replace_record(thread_db*, record_param*, PageStack*, const jrd_tra*);
 static void refresh_fk_fields(thread_db*, Record*, record_param*, record_param*);
 static SSHORT set_metadata_id(thread_db*, Record*, USHORT, drq_type_t, const char*);
@@ -826,6 +827,8 @@ void VIO_backout(thread_db* tdbb, record_param* rpb, const jrd_tra* transaction)
 
 	fb_assert(assert_gc_enabled(transaction, rpb->rpb_relation));
 
+	tdbb->getAttachment()->att_data_changes++;
+
 	jrd_rel* const relation = rpb->rpb_relation;
 
 #ifdef VIO_DEBUG
@@ -1969,6 +1972,8 @@ bool VIO_erase(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 	Request* request = tdbb->getRequest();
 	jrd_rel* relation = rpb->rpb_relation;
 
+	tdbb->getAttachment()->att_data_changes++;
+
 #ifdef VIO_DEBUG
 	VIO_trace(DEBUG_WRITES,
 		"VIO_erase (rel_id %u, record_param %" QUADFORMAT"d, transaction %" SQUADFORMAT")\n",
@@ -3292,6 +3297,8 @@ bool VIO_modify(thread_db* tdbb, record_param* org_rpb, record_param* new_rpb, j
 	MetaName object_name, package_name;
 	jrd_rel* relation = org_rpb->rpb_relation;
 
+	tdbb->getAttachment()->att_data_changes++;
+
 #ifdef VIO_DEBUG
 	VIO_trace(DEBUG_WRITES,
 		"VIO_modify (rel_id %u, org_rpb %" QUADFORMAT"d, new_rpb %" QUADFORMAT"d, "
@@ -3711,6 +3718,15 @@ bool VIO_modify(thread_db* tdbb, record_param* org_rpb, record_param* new_rpb, j
 		return true;
 	}
 
+	// Hot row fast path: if the version being updated was committed before
+	// the oldest active snapshot, its back versions are invisible to everybody.
+	// Purge them right now, so the back version we're about to create may
+	// reuse their space on the same data page. If they are purged, the rest
+	// goes on as for a record without back versions.
+
+	if (org_rpb->rpb_b_page)
+		purge_before_update(tdbb, transaction, org_rpb);
+
 	const bool backVersion = (org_rpb->rpb_b_page != 0);
 	record_param temp;
 	PageStack stack;
@@ -3986,6 +4002,8 @@ void VIO_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 	Request* const request = tdbb->getRequest();
 	jrd_rel* relation = rpb->rpb_relation;
 
+	tdbb->getAttachment()->att_data_changes++;
+
 	DeferredWork* work = NULL;
 	MetaName package_name;
 	USHORT object_id;
@@ -6559,6 +6577,73 @@ static void purge(thread_db* tdbb, record_param* rpb)
 }
 
 
+static void purge_before_update(thread_db* tdbb, jrd_tra* transaction, record_param* rpb)
+{
+/**************************************
+ *
+ *	p u r g e _ b e f o r e _ u p d a t e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Purge old versions of a record that is about to be updated,
+ *	if the version being updated is mature enough. Frequently updated
+ *	("hot") rows otherwise keep growing their version chains until
+ *	somebody else reads them or the garbage collector comes by.
+ *	On success, the back pointer of the passed record is reset.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+	Database* const dbb = tdbb->getDatabase();
+	Attachment* const attachment = tdbb->getAttachment();
+	jrd_rel* const relation = rpb->rpb_relation;
+
+	if (!(dbb->dbb_flags & DBB_gc_cooperative) || (attachment->att_flags & ATT_no_cleanup))
+		return;
+
+	const TraNumber oldest_snapshot = relation->isTemporary() ?
+		attachment->att_oldest_snapshot : transaction->tra_oldest_active;
+
+	if (rpb->rpb_transaction_nr >= oldest_snapshot)
+		return;
+
+	// Versions of dead or limbo transactions are not mature whatever their numbers are
+
+	if (TRA_snapshot_state(tdbb, transaction, rpb->rpb_transaction_nr) != tra_committed)
+		return;
+
+	jrd_rel::GCShared gcGuard(tdbb, relation);
+
+	if (!gcGuard.gcEnabled())
+		return;
+
+	// Work on a copy, the caller relies on its record_param
+	// to detect concurrent updates inside prepare_update()
+
+	record_param temp = *rpb;
+
+	if (!DPM_get(tdbb, &temp, LCK_read))
+		return;
+
+	if (temp.rpb_transaction_nr != rpb->rpb_transaction_nr ||
+		temp.rpb_b_page != rpb->rpb_b_page || temp.rpb_b_line != rpb->rpb_b_line ||
+		(temp.rpb_flags & (rpb_deleted | rpb_chained | rpb_gc_active | rpb_damaged)))
+	{
+		CCH_RELEASE(tdbb, &temp.getWindow(tdbb));
+		return;
+	}
+
+	purge(tdbb, &temp);
+
+	if (!temp.rpb_b_page && temp.rpb_transaction_nr == rpb->rpb_transaction_nr)
+	{
+		rpb->rpb_b_page = 0;
+		rpb->rpb_b_line = 0;
+		rpb->rpb_flags &= ~(rpb_delta | rpb_gc_active);
+	}
+}
+
+
 static void replace_record(thread_db*		tdbb,
 						   record_param*	rpb,
 						   PageStack*		stack,
@@ -6833,6 +6918,8 @@ void VIO_update_in_place(thread_db* tdbb,
 	Database* dbb = tdbb->getDatabase();
 	CHECK_DBB(dbb);
 
+	tdbb->getAttachment()->att_data_changes++;
+
 	jrd_rel* const relation = org_rpb->rpb_relation;
 #ifdef VIO_DEBUG
 	VIO_trace(DEBUG_TRACE_ALL,
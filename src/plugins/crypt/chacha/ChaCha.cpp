@@ -1,7 +1,7 @@
 /*
  *	PROGRAM:		Firebird authentication.
  *	MODULE:			ChaCha.cpp
- *	DESCRIPTION:	ChaCha wire crypt plugin.
+ *	DESCRIPTION:	ChaCha and AES-CTR wire crypt plugins.
  *
  *  The contents of this file are subject to the Initial
  *  Developer's Public License Version 1.0 (the "License");
@@ -31,6 +31,18 @@
 #include <tomcrypt.h>
 #include <../common/os/guid.h>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+#define AES_NI_SUPPORT
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AES_NI_TARGET
+#else
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define AES_NI_TARGET __attribute__((target("aes,sse2")))
+#endif
+#endif
+
 using namespace Firebird;
 
 namespace
@@ -50,10 +62,10 @@ void tomCheck(int err, const char* text, int specErr = CRYPT_OK,  const char* sp
 }
 
 
-class Cipher : public GlobalStorage
+class ChaChaCipher : public GlobalStorage
 {
 public:
-	Cipher(const unsigned char* key, unsigned int ivlen, const unsigned char* iv)
+	ChaChaCipher(const unsigned char* key, unsigned int ivlen, const unsigned char* iv)
 	{
 		tomCheck(chacha_setup(&chacha, key, 32, 20), "initializing CHACHA#20");
 
@@ -88,11 +100,219 @@ private:
 };
 
 
-template <unsigned IV_SIZE>
-class ChaCha final : public StdPlugin<IWireCryptPluginImpl<ChaCha<IV_SIZE>, CheckStatusWrapper> >
+#ifdef AES_NI_SUPPORT
+
+bool aesNiSupported()
+{
+#ifdef _MSC_VER
+	const int bit_AES = 1 << 25;
+	int flags[4];
+	__cpuid(flags, 1);
+	return (flags[2] & bit_AES) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+	return (ecx & bit_AES) != 0;
+#endif
+}
+
+const bool useAesNi = aesNiSupported();
+
+AES_NI_TARGET inline __m128i aesKeyAssist1(__m128i t1, __m128i t2)
+{
+	t2 = _mm_shuffle_epi32(t2, 0xff);
+	__m128i t4 = _mm_slli_si128(t1, 4);
+	t1 = _mm_xor_si128(t1, t4);
+	t4 = _mm_slli_si128(t4, 4);
+	t1 = _mm_xor_si128(t1, t4);
+	t4 = _mm_slli_si128(t4, 4);
+	t1 = _mm_xor_si128(t1, t4);
+	return _mm_xor_si128(t1, t2);
+}
+
+AES_NI_TARGET inline __m128i aesKeyAssist2(__m128i t1, __m128i t3)
+{
+	const __m128i t2 = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(t1, 0), 0xaa);
+	__m128i t4 = _mm_slli_si128(t3, 4);
+	t3 = _mm_xor_si128(t3, t4);
+	t4 = _mm_slli_si128(t4, 4);
+	t3 = _mm_xor_si128(t3, t4);
+	t4 = _mm_slli_si128(t4, 4);
+	t3 = _mm_xor_si128(t3, t4);
+	return _mm_xor_si128(t3, t2);
+}
+
+// Expand 256-bit key into 15 round keys
+
+AES_NI_TARGET void aesNiExpandKey(const unsigned char* key, unsigned char* schedule)
+{
+	__m128i k[15];
+	__m128i t1 = k[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+	__m128i t3 = k[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+
+	// _mm_aeskeygenassist_si128() needs constant round value, therefore no loop here
+	t1 = k[2] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x01));
+	t3 = k[3] = aesKeyAssist2(t1, t3);
+	t1 = k[4] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x02));
+	t3 = k[5] = aesKeyAssist2(t1, t3);
+	t1 = k[6] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x04));
+	t3 = k[7] = aesKeyAssist2(t1, t3);
+	t1 = k[8] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x08));
+	t3 = k[9] = aesKeyAssist2(t1, t3);
+	t1 = k[10] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x10));
+	t3 = k[11] = aesKeyAssist2(t1, t3);
+	t1 = k[12] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x20));
+	t3 = k[13] = aesKeyAssist2(t1, t3);
+	k[14] = aesKeyAssist1(t1, _mm_aeskeygenassist_si128(t3, 0x40));
+
+	for (unsigned i = 0; i < 15; ++i)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(schedule + i * 16), k[i]);
+}
+
+// Encrypt 8 blocks at once - independent blocks keep AES unit pipeline busy
+
+AES_NI_TARGET void aesNiEncrypt8(const unsigned char* schedule, const unsigned char* in, unsigned char* out)
+{
+	__m128i b[8];
+	__m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(schedule));
+
+	for (unsigned i = 0; i < 8; ++i)
+		b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 16)), k);
+
+	for (unsigned r = 1; r < 14; ++r)
+	{
+		k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(schedule + r * 16));
+		for (unsigned i = 0; i < 8; ++i)
+			b[i] = _mm_aesenc_si128(b[i], k);
+	}
+
+	k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(schedule + 14 * 16));
+	for (unsigned i = 0; i < 8; ++i)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), _mm_aesenclast_si128(b[i], k));
+}
+
+#endif // AES_NI_SUPPORT
+
+
+// AES-256 in counter mode, 128-bit big-endian counter starting from IV.
+// Key stream is generated with AES-NI instructions when CPU supports them
+// or by tomcrypt - both produce the same stream, therefore peers need not
+// match in CPU features.
+
+class AesCipher : public GlobalStorage
+{
+	static const unsigned BLOCK_SIZE = 16;
+	static const unsigned BLOCKS = 8;		// blocks of key stream generated at once
+
+public:
+	AesCipher(const unsigned char* key, unsigned int ivlen, const unsigned char* iv)
+		: padPos(sizeof(pad))
+	{
+		if (ivlen != BLOCK_SIZE)
+			(Arg::Gds(isc_random) << "Wrong IV length, need 16").raise();
+
+		memcpy(counter, iv, BLOCK_SIZE);
+
+#ifdef AES_NI_SUPPORT
+		if (useAesNi)
+		{
+			aesNiExpandKey(key, schedule);
+			return;
+		}
+#endif
+		tomCheck(aes_setup(key, 32, 0, &skey), "initializing AES");
+	}
+
+	~AesCipher()
+	{
+#ifdef AES_NI_SUPPORT
+		if (useAesNi)
+			return;
+#endif
+		aes_done(&skey);
+	}
+
+	void transform(unsigned int length, const void* from, void* to)
+	{
+		unsigned char* t = static_cast<unsigned char*>(to);
+		const unsigned char* f = static_cast<const unsigned char*>(from);
+
+		while (length)
+		{
+			if (padPos == sizeof(pad))
+			{
+				generate();
+				padPos = 0;
+			}
+
+			unsigned n = MIN(length, sizeof(pad) - padPos);
+			length -= n;
+
+			const unsigned char* p = pad + padPos;
+			padPos += n;
+
+			for (; n >= sizeof(FB_UINT64); n -= sizeof(FB_UINT64))
+			{
+				FB_UINT64 a, b;
+				memcpy(&a, f, sizeof(a));
+				memcpy(&b, p, sizeof(b));
+				a ^= b;
+				memcpy(t, &a, sizeof(a));
+
+				f += sizeof(a);
+				t += sizeof(a);
+				p += sizeof(a);
+			}
+
+			while (n--)
+				*t++ = *f++ ^ *p++;
+		}
+	}
+
+private:
+	void generate()
+	{
+		unsigned char blocks[sizeof(pad)];
+
+		for (unsigned i = 0; i < BLOCKS; ++i)
+		{
+			memcpy(blocks + i * BLOCK_SIZE, counter, BLOCK_SIZE);
+
+			for (int x = BLOCK_SIZE - 1; x >= 0; --x)
+			{
+				if (++counter[x])
+					break;
+			}
+		}
+
+#ifdef AES_NI_SUPPORT
+		if (useAesNi)
+		{
+			aesNiEncrypt8(schedule, blocks, pad);
+			return;
+		}
+#endif
+
+		for (unsigned i = 0; i < BLOCKS; ++i)
+			tomCheck(aes_ecb_encrypt(blocks + i * BLOCK_SIZE, pad + i * BLOCK_SIZE, &skey), "processing AES");
+	}
+
+	unsigned char counter[BLOCK_SIZE];
+	unsigned char pad[BLOCK_SIZE * BLOCKS];
+	unsigned padPos;
+#ifdef AES_NI_SUPPORT
+	unsigned char schedule[BLOCK_SIZE * 15];
+#endif
+	symmetric_key skey;
+};
+
+
+template <class CIPHER, unsigned IV_SIZE>
+class CryptPlugin final : public StdPlugin<IWireCryptPluginImpl<CryptPlugin<CIPHER, IV_SIZE>, CheckStatusWrapper> >
 {
 public:
-	explicit ChaCha(IPluginConfig*)
+	explicit CryptPlugin(IPluginConfig*)
 		: en(NULL), de(NULL), iv(this->getPool())
 	{
 		if (IV_SIZE == 16)
@@ -166,7 +386,7 @@ public:
 	}
 
 private:
-	Cipher* createCypher(unsigned int l, const void* key)
+	CIPHER* createCypher(unsigned int l, const void* key)
 	{
 		if (l < 16)
 			(Arg::Gds(isc_random) << "Key too short").raise();
@@ -177,15 +397,16 @@ private:
 		unsigned char stretched[32];
 		tomCheck(sha256_done(&md, stretched), "getting stretched key from sha256");
 
-		return FB_NEW Cipher(stretched, iv.getCount(), iv.begin());
+		return FB_NEW CIPHER(stretched, iv.getCount(), iv.begin());
 	}
 
-	AutoPtr<Cipher> en, de;
+	AutoPtr<CIPHER> en, de;
 	UCharBuffer iv;
 };
 
-SimpleFactory<ChaCha<16> > factory;
-SimpleFactory<ChaCha<8> > factory64;
+SimpleFactory<CryptPlugin<ChaChaCipher, 16> > factory;
+SimpleFactory<CryptPlugin<ChaChaCipher, 8> > factory64;
+SimpleFactory<CryptPlugin<AesCipher, 16> > factoryAes;
 
 } // anonymous namespace
 
@@ -194,5 +415,6 @@ extern "C" FB_DLL_EXPORT void FB_PLUGIN_ENTRY_POINT(Firebird::IMaster* master)
 	CachedMasterInterface::set(master);
 	PluginManagerInterfacePtr()->registerPluginFactory(IPluginManager::TYPE_WIRE_CRYPT, "ChaCha", &factory);
 	PluginManagerInterfacePtr()->registerPluginFactory(IPluginManager::TYPE_WIRE_CRYPT, "ChaCha64", &factory64);
+	PluginManagerInterfacePtr()->registerPluginFactory(IPluginManager::TYPE_WIRE_CRYPT, "AesCtr", &factoryAes);
 	getUnloadDetector()->registerMe();
 }
@@ -95,6 +95,8 @@ const char* const PROTOCOL_INET6 = "inet6";
 
 #ifdef WIN_NT
 const char* const PROTOCOL_XNET = "xnet";
+#else
+const char* const PROTOCOL_UNIX = "unix";
 #endif
 
 const char* const INET_SEPARATOR = "/";
@@ -1123,6 +1125,7 @@ static rem_port* analyze(ClntAuthBlock& cBlock, PathName& attach_name, unsigned
 	ICryptKeyCallback* cryptCb);
 static void batch_gds_receive(rem_port*, struct rmtque *, USHORT);
 static void batch_dsql_fetch(rem_port*, struct rmtque *, USHORT);
+static void blob_read_ahead(rem_port*, struct rmtque *, USHORT);
 static void clear_queue(rem_port*);
 static void clear_stmt_que(rem_port*, Rsr*);
 static void finalize(rem_port* port);
@@ -1130,6 +1133,7 @@ static void disconnect(rem_port*, bool rmRef = true);
 static void enqueue_receive(rem_port*, t_rmtque_fn, Rdb*, void*, Rrq::rrq_repeat*);
 static void dequeue_receive(rem_port*);
 static THREAD_ENTRY_DECLARE event_thread(THREAD_ENTRY_PARAM);
+static USHORT fetch_rows(Rsr*);
 static Rvnt* find_event(rem_port*, SLONG);
 static bool get_new_dpb(ClumpletWriter&, const ParametersSet&, bool);
 static void info(CheckStatusWrapper*, Rdb*, P_OP, USHORT, USHORT, USHORT,
@@ -4894,6 +4898,8 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 
 		statement->rsr_flags.clear(Rsr::STREAM_END | Rsr::PAST_END | Rsr::STREAM_ERR);
 		statement->rsr_rows_pending = 0;
+		statement->rsr_fetch_consumed = statement->rsr_fetch_total = 0;
+		statement->rsr_fetch_clock = statement->rsr_consume_time = statement->rsr_wait_time = 0;
 		statement->rsr_fetch_operation = operation;
 		statement->rsr_fetch_position = position;
 		statement->clearException();
@@ -5121,8 +5127,8 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 		{
 			if (operation == fetch_next || operation == fetch_prior)
 			{
-				sqldata->p_sqldata_messages = REMOTE_compute_batch_size(
-					port, 0, op_fetch_response, statement->rsr_select_format);
+				sqldata->p_sqldata_messages = statement->rsr_fetch_rows = REMOTE_fetch_batch_size(
+					port, statement->rsr_select_format, fetch_rows(statement));
 			}
 
 			// Reorder data when the local buffer is half empty
@@ -5171,6 +5177,12 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 	fb_assert(statement->rsr_msgs_waiting || statement->rsr_rows_pending ||
 			  statement->haveException() || statement->rsr_flags.test(Rsr::STREAM_END));
 
+	// Time spent by the client since the previous row was returned to it
+
+	const SINT64 started = fb_utils::query_performance_counter();
+	if (statement->rsr_fetch_clock)
+		statement->rsr_consume_time += started - statement->rsr_fetch_clock;
+
 	while (!statement->haveException() &&			// received a database error
 		!statement->rsr_flags.test(Rsr::STREAM_END) &&	// reached end of stream
 		statement->rsr_msgs_waiting < 2	&&			// Have looked ahead for end of batch
@@ -5180,6 +5192,12 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 		receive_queued_packet(port, statement->rsr_id);
 	}
 
+	// Time spent by the client waiting for rows
+
+	const SINT64 received = fb_utils::query_performance_counter();
+	statement->rsr_wait_time += received - started;
+	statement->rsr_fetch_clock = received;
+
 	if (!statement->rsr_msgs_waiting)
 	{
 		if (statement->rsr_flags.test(Rsr::STREAM_END))
@@ -5219,6 +5237,8 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 	}
 
 	statement->rsr_msgs_waiting--;
+	statement->rsr_fetch_consumed++;
+	statement->rsr_fetch_total++;
 
 	message = statement->rsr_message;
 	statement->rsr_message = message->msg_next;
@@ -5759,26 +5779,71 @@ int Blob::getSegment(CheckStatusWrapper* status, unsigned int bufferLength, void
 				blob->rbl_buffer_length = (USHORT) new_size;
 			}
 
-			// We need more data.  Ask for it politely
+			// If the next chunk was requested in advance, pick up its response
 
-			packet->p_operation = op_get_segment;
-			segment->p_sgmt_length = blob->rbl_buffer_length;
-			segment->p_sgmt_blob = blob->rbl_id;
-			segment->p_sgmt_segment.cstr_length = 0;
-			send_packet(rdb->rdb_port, packet);
+			while (blob->rbl_flags & Rbl::READ_AHEAD)
+				receive_queued_packet(port, blob->rbl_id);
 
-			response->p_resp_data.cstr_allocated = blob->rbl_buffer_length;
-			response->p_resp_data.cstr_address = blob->rbl_buffer;
+			USHORT object;
 
-			receive_response(status, rdb, packet);
+			if (blob->rbl_flags & Rbl::AHEAD_READY)
+			{
+				blob->rbl_flags &= ~Rbl::AHEAD_READY;
+
+				if (blob->rbl_ahead_length > blob->rbl_buffer_length)
+				{
+					blob->rbl_buffer = blob->rbl_data.getBuffer(blob->rbl_ahead_length);
+					blob->rbl_buffer_length = blob->rbl_ahead_length;
+				}
+
+				memcpy(blob->rbl_buffer, blob->rbl_ahead.begin(), blob->rbl_ahead_length);
+				blob->rbl_length = blob->rbl_ahead_length;
+				object = blob->rbl_ahead_object;
+			}
+			else
+			{
+				// We need more data.  Ask for it politely
+
+				packet->p_operation = op_get_segment;
+				segment->p_sgmt_length = blob->rbl_buffer_length;
+				segment->p_sgmt_blob = blob->rbl_id;
+				segment->p_sgmt_segment.cstr_length = 0;
+				send_packet(rdb->rdb_port, packet);
+
+				response->p_resp_data.cstr_allocated = blob->rbl_buffer_length;
+				response->p_resp_data.cstr_address = blob->rbl_buffer;
+
+				receive_response(status, rdb, packet);
+
+				blob->rbl_length = (USHORT) response->p_resp_data.cstr_length;
+				object = response->p_resp_object;
+			}
 
-			blob->rbl_length = (USHORT) response->p_resp_data.cstr_length;
 			blob->rbl_ptr = blob->rbl_buffer;
 			blob->rbl_flags &= ~Rbl::SEGMENT;
-			if (response->p_resp_object == 1)
+			if (object == 1)
 				blob->rbl_flags |= Rbl::SEGMENT;
-			else if (response->p_resp_object == 2)
+			else if (object == 2)
 				blob->rbl_flags |= Rbl::EOF_PENDING;
+
+			// The blob is read sequentially and has more than one chunk - stream it:
+			// ask for the next big chunk now, it will travel while the current one
+			// is consumed by application.
+
+			if (!(blob->rbl_flags & Rbl::EOF_PENDING) && blob->rbl_offset &&
+				port->port_type == rem_port::INET)
+			{
+				blob->rbl_ahead.getBuffer(BLOB_STREAM_LENGTH);
+
+				packet->p_operation = op_get_segment;
+				segment->p_sgmt_length = BLOB_STREAM_LENGTH;
+				segment->p_sgmt_blob = blob->rbl_id;
+				segment->p_sgmt_segment.cstr_length = 0;
+				send_packet(port, packet);
+
+				enqueue_receive(port, blob_read_ahead, rdb, blob, NULL);
+				blob->rbl_flags |= Rbl::READ_AHEAD;
+			}
 		}
 
 		if (segmentLength)
@@ -6902,7 +6967,7 @@ int Blob::seek(CheckStatusWrapper* status, int mode, int offset)
 		blob->rbl_offset = packet->p_resp.p_resp_blob_id.gds_quad_low;
 		blob->rbl_length = 0;
 		blob->rbl_fragment_length = 0;
-		blob->rbl_flags &= ~(Rbl::EOF_SET | Rbl::EOF_PENDING | Rbl::SEGMENT);
+		blob->rbl_flags &= ~(Rbl::EOF_SET | Rbl::EOF_PENDING | Rbl::SEGMENT | Rbl::AHEAD_READY);
 
 		return blob->rbl_offset;
 	}
@@ -7921,6 +7986,10 @@ static rem_port* analyze(ClntAuthBlock& cBlock, PathName& attach_name, unsigned
 			if (ISC_analyze_protocol(PROTOCOL_XNET, attach_name, node_name, NULL, needFile))
 				port = XNET_analyze(&cBlock, attach_name, flags & ANALYZE_USER_VFY, cBlock.getConfig(), ref_db_name);
 			else
+#else
+			if (ISC_analyze_protocol(PROTOCOL_UNIX, attach_name, node_name, NULL, needFile))
+				inet_af = AF_UNIX;
+			else
 #endif
 
 			if (ISC_analyze_protocol(PROTOCOL_INET4, attach_name, node_name, INET_SEPARATOR, needFile))
@@ -8432,6 +8501,58 @@ static void batch_gds_receive(rem_port*		port,
 }
 
 
+static void blob_read_ahead(rem_port* port, rmtque* que_inst, USHORT id)
+{
+/**************************************
+ *
+ *	b l o b _ r e a d _ a h e a d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Receive the chunk of blob requested in advance.
+ *	Errors are not reported here - if the chunk is
+ *	not received, it's requested once more when needed.
+ *
+ **************************************/
+
+	fb_assert(port);
+	fb_assert(que_inst);
+	fb_assert(que_inst->rmtque_function == blob_read_ahead);
+
+	Rdb* rdb = que_inst->rmtque_rdb;
+	Rbl* blob = static_cast<Rbl*>(que_inst->rmtque_parm);
+	PACKET* packet = &rdb->rdb_packet;
+	P_RESP* response = &packet->p_resp;
+
+	fb_assert(port == rdb->rdb_port);
+
+	blob->rbl_flags &= ~Rbl::READ_AHEAD;
+	dequeue_receive(port);
+
+	UsePreallocatedBuffer temp(response->p_resp_data, blob->rbl_ahead.getCapacity(),
+		blob->rbl_ahead.begin());
+
+	receive_packet_noqueue(port, packet);
+
+	LocalStatus ls;
+	CheckStatusWrapper status(&ls);
+
+	try
+	{
+		REMOTE_check_response(&status, rdb, packet);
+	}
+	catch (const Exception&)
+	{
+		return;
+	}
+
+	blob->rbl_ahead_length = (USHORT) response->p_resp_data.cstr_length;
+	blob->rbl_ahead_object = response->p_resp_object;
+	blob->rbl_flags |= Rbl::AHEAD_READY;
+}
+
+
 static void clear_queue(rem_port* port)
 {
 /**************************************
@@ -8647,6 +8768,56 @@ static THREAD_ENTRY_DECLARE event_thread(THREAD_ENTRY_PARAM arg)
 }
 
 
+static USHORT fetch_rows(Rsr* statement)
+{
+/**************************************
+ *
+ *	f e t c h _ r o w s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Estimate the number of rows to request by the next
+ *	batch from the timings measured since the previous
+ *	request. If the client had to wait for rows, the batch
+ *	is grown by the rows it could consume while waiting,
+ *	twice as the next batch is requested when a half of
+ *	the current one is consumed. If the client didn't wait,
+ *	the batch is shrunk by a quarter. The estimate never
+ *	exceeds the number of rows consumed since the first
+ *	fetch, thus short result sets are not prefetched in
+ *	large batches. REMOTE_fetch_batch_size() keeps it
+ *	between the default batch and the fetch window.
+ *
+ **************************************/
+	ULONG rows = statement->rsr_fetch_rows;
+	const ULONG consumed = statement->rsr_fetch_consumed;
+	const SINT64 consumeTime = statement->rsr_consume_time;
+	const SINT64 waitTime = statement->rsr_wait_time;
+
+	statement->rsr_fetch_consumed = 0;
+	statement->rsr_consume_time = statement->rsr_wait_time = 0;
+
+	if (consumed)
+	{
+		// Short waits are not worth the memory, waits much shorter than
+		// the time spent consuming rows mean the batch is larger than needed
+
+		if (waitTime > consumeTime / 8)
+		{
+			const double waitRows = (consumeTime > 0) ?
+				(double) waitTime * consumed / consumeTime : (double) MAX_USHORT;
+
+			rows += (ULONG) MIN(2 * waitRows, (double) MAX_USHORT);
+		}
+		else if (waitTime < consumeTime / 64)
+			rows -= rows / 4;
+	}
+
+	return (USHORT) MIN(MIN(rows, statement->rsr_fetch_total), (ULONG) MAX_USHORT);
+}
+
+
 static Rvnt* find_event( rem_port* port, SLONG id)
 {
 /*************************************
@@ -8880,7 +9051,7 @@ static void authReceiveResponse(bool havePacket, ClntAuthBlock& cBlock, rem_port
 				n->cstr_length, n->cstr_address, n->cstr_address ? n->cstr_address[0] : 0));
 			if (packet->p_acpd.p_acpt_type & pflag_compress)
 			{
-				port->initCompression();
+				port->initCompression(packet->p_acpd.p_acpt_type & pflag_compress_zstd);
 				port->port_flags |= PORT_compressed;
 			}
 			packet->p_acpd.p_acpt_type &= ptype_MASK;
@@ -9556,6 +9727,23 @@ static void release_blob( Rbl* blob)
 	Rtr* transaction = blob->rbl_rtr;
 	Rdb* rdb = blob->rbl_rdb;
 
+	if (blob->rbl_flags & Rbl::READ_AHEAD)
+	{
+		// Connection is lost, else response would be already received.
+		// Make sure nobody tries to receive into released blob.
+
+		for (rmtque** que = &rdb->rdb_port->port_receive_rmtque; *que; que = &(*que)->rmtque_next)
+		{
+			if ((*que)->rmtque_parm == blob)
+			{
+				rmtque* const que_inst = *que;
+				*que = que_inst->rmtque_next;
+				delete que_inst;
+				break;
+			}
+		}
+	}
+
 	if (blob->isCached())
 	{
 		// Assume buffer was not resized while blob was cached
@@ -88,6 +88,11 @@
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <sys/wait.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 
 #if defined(HAVE_POLL_H)
 #include <poll.h>
@@ -95,6 +100,11 @@
 #include <sys/select.h>
 #endif
 
+#if defined(LINUX) && defined(HAVE_POLL)
+#include <sys/epoll.h>
+#define INET_EPOLL
+#endif
+
 #endif // !WIN_NT
 
 constexpr int INET_RETRY_CALL = 5;
@@ -234,6 +244,9 @@ constexpr int SELECT_TIMEOUT	= 60;		// Dispatch thread select timeout (sec)
 
 class Select
 {
+public:
+	enum HandleState {SEL_BAD, SEL_DISCONNECTED, SEL_NO_DATA, SEL_READY};
+
 #ifdef HAVE_POLL
 private:
 	static constexpr int SEL_INIT_EVENTS = POLLIN;
@@ -249,15 +262,64 @@ private:
 	}
 #endif
 
+#ifdef INET_EPOLL
+	static constexpr int SEL_MAX_EVENTS = 256;
+
+	// Descriptor watched by epoll and the port it belongs to. The port is
+	// referenced while it's watched, thus a descriptor reused by another
+	// port could not be mistaken for the already registered one.
+	struct EpollItem
+	{
+		SOCKET fd;
+		rem_port* port;
+
+		static SOCKET generate(const EpollItem& item) { return item.fd; }
+	};
+
+	typedef SortedArray<EpollItem, EmptyStorage<EpollItem>, SOCKET, EpollItem> EpollItems;
+
+	// Drop the reference taken when the port was registered
+	static void unwatch(rem_port* port)
+	{
+		RemPortPtr ref(REF_NO_INCR, port);
+	}
+
+	const EpollItem* findItem(SOCKET fd) const
+	{
+		FB_SIZE_T pos;
+		if (slct_watched.find(fd, pos))
+			return &slct_watched[pos];
+
+		if (slct_polled.find(fd, pos))
+			return &slct_polled[pos];
+
+		return nullptr;
+	}
+
+	void epollSync();
+	void epollSelect(int milliseconds);
+	HandleState epollNext(RemPortPtr& port);
+#endif
+
 public:
 #ifdef HAVE_POLL
 	Select()
 		: slct_time(0), slct_count(0), slct_poll(*getDefaultMemoryPool()),
 		  slct_ready(*getDefaultMemoryPool())
+#ifdef INET_EPOLL
+		  , slct_epoll(-1), slct_wanted(*getDefaultMemoryPool()),
+		  slct_watched(*getDefaultMemoryPool()), slct_polled(*getDefaultMemoryPool()),
+		  slct_fired(*getDefaultMemoryPool()),
+		  slct_expired(*getDefaultMemoryPool()), slct_changed(true), slct_sync(false), slct_scan(false)
+#endif
 	{ }
 
 	explicit Select(MemoryPool& pool)
 		: slct_time(0), slct_count(0), slct_poll(pool), slct_ready(pool)
+#ifdef INET_EPOLL
+		  , slct_epoll(-1), slct_wanted(pool), slct_watched(pool), slct_polled(pool), slct_fired(pool),
+		  slct_expired(pool), slct_changed(true), slct_sync(false), slct_scan(false)
+#endif
 	{ }
 #else
 	Select()
@@ -273,7 +335,63 @@ public:
 	}
 #endif
 
-	enum HandleState {SEL_BAD, SEL_DISCONNECTED, SEL_NO_DATA, SEL_READY};
+#ifdef INET_EPOLL
+	~Select()
+	{
+		for (auto& item : slct_watched)
+			unwatch(item.port);
+
+		for (auto& item : slct_polled)
+			unwatch(item.port);
+
+		if (slct_epoll >= 0)
+			close(slct_epoll);
+	}
+#endif
+
+	// Use epoll instead of poll() when available. The set of descriptors is
+	// kept by the kernel between the waits, so only the changes are passed
+	// to it and only ready descriptors are reported back. Worth it for the
+	// main listener port of the multi-client server that waits on all
+	// client ports at once. Returns true if epoll is used.
+	bool useEpoll()
+	{
+#ifdef INET_EPOLL
+		if (slct_epoll < 0)
+			slct_epoll = epoll_create1(EPOLL_CLOEXEC);	// on failure poll() is used
+
+		return slct_epoll >= 0;
+#else
+		return false;
+#endif
+	}
+
+	// Ports were added, removed or got another descriptor, the set of
+	// descriptors watched by epoll should be rebuilt before the next wait
+	void portsChanged()
+	{
+#ifdef INET_EPOLL
+		slct_changed = true;
+#endif
+	}
+
+	bool checkChanges()
+	{
+#ifdef INET_EPOLL
+		return slct_changed.exchange(false);
+#else
+		return true;
+#endif
+	}
+
+	// keepalive timer of the port owning the handle has expired
+	void expire(SOCKET handle)
+	{
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0)
+			slct_expired.add(handle);
+#endif
+	}
 
 	// set first port to check for readiness
 	void checkStart(RemPortPtr& port)
@@ -304,6 +422,11 @@ public:
 		}
 #endif
 
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0 && !slct_scan)
+			return epollNext(port);
+#endif
+
 		if (slct_port && slct_port->port_state == rem_port::DISCONNECTED)
 		{
 			// restart from main port
@@ -341,6 +464,18 @@ public:
 			return SEL_READY;
 #endif
 		SOCKET n = port->port_handle;
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0)
+		{
+			FB_SIZE_T pos;
+			if (slct_fired.find(n, pos))
+			{
+				slct_fired.remove(pos);
+				return SEL_READY;
+			}
+			return n < 0 ? (port->port_flags & PORT_disconnect ? SEL_DISCONNECTED : SEL_BAD) : SEL_NO_DATA;
+		}
+#endif
 #if defined(WIN_NT)
 		if (FD_ISSET(n, &slct_fdset))
 		{
@@ -377,6 +512,15 @@ public:
 
 	void unset(SOCKET handle)
 	{
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0)
+		{
+			FB_SIZE_T pos;
+			if (slct_fired.find(handle, pos))
+				slct_fired.remove(pos);
+			return;
+		}
+#endif
 #if defined(HAVE_POLL)
 		pollfd* pf = getPollFd(handle);
 		if (pf)
@@ -389,8 +533,31 @@ public:
 #endif
 	}
 
-	void set(SOCKET handle)
+	// port is the owner of the handle, used to track descriptors watched by epoll
+	void set(SOCKET handle, rem_port* port = nullptr)
 	{
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0)
+		{
+			FB_SIZE_T pos;
+			if (!port)
+			{
+				// Unknown owner, just report the handle as ready
+				// and look for its port walking all of them
+				if (!slct_fired.find(handle, pos))
+					slct_fired.insert(pos, handle);
+				slct_scan = true;
+			}
+			else if (!slct_wanted.find(handle, pos))
+			{
+				EpollItem item;
+				item.fd = handle;
+				item.port = port;
+				slct_wanted.insert(pos, item);
+			}
+			return;
+		}
+#endif
 #ifdef HAVE_POLL
 		FB_SIZE_T pos;
 		if (slct_poll.find(handle, pos))
@@ -417,6 +584,13 @@ public:
 	void clear()
 	{
 		slct_count = 0;
+#ifdef INET_EPOLL
+		slct_wanted.clear();
+		slct_fired.clear();
+		slct_expired.clear();
+		slct_sync = true;
+		slct_scan = false;
+#endif
 #if defined(HAVE_POLL)
 		slct_poll.clear();
 #else
@@ -432,6 +606,13 @@ public:
 
 	void select(timeval* timeout)
 	{
+#ifdef INET_EPOLL
+		if (slct_epoll >= 0)
+		{
+			epollSelect(timeout ? timeout->tv_sec * 1000 + timeout->tv_usec / 1000 : -1);
+			return;
+		}
+#endif
 #ifdef HAVE_POLL
 		slct_ready.clear();
 		bool hasRequest = false;
@@ -490,6 +671,17 @@ private:
 
 	SortedArray<pollfd, InlineStorage<pollfd, 8>, int, PollToFD>  slct_poll;
 	SortedArray<pollfd*, InlineStorage<pollfd*, 8>, int, PollToFD>  slct_ready;
+#ifdef INET_EPOLL
+	int slct_epoll;					// epoll instance, -1 if poll() is used
+	EpollItems slct_wanted;			// descriptors to wait for
+	EpollItems slct_watched;		// descriptors registered in epoll instance
+	EpollItems slct_polled;			// descriptors epoll failed to register, poll() is used for them
+	SortedArray<SOCKET> slct_fired;	// descriptors ready for reading
+	Array<SOCKET> slct_expired;		// descriptors of ports with expired keepalive timer
+	std::atomic<bool> slct_changed;	// set of ports was changed since the last wait
+	bool slct_sync;					// slct_wanted was rebuilt, sync it with epoll instance
+	bool slct_scan;					// walk all ports to find the ready ones
+#endif
 #else
 	int		slct_width;
 	fd_set	slct_fdset;
@@ -501,6 +693,242 @@ private:
 #endif
 };
 
+#ifdef INET_EPOLL
+void Select::epollSync()
+{
+/**************************************
+ *
+ *	S e l e c t : : e p o l l S y n c
+ *
+ **************************************
+ *
+ * Functional description
+ *	Make the epoll instance watch exactly the
+ *	descriptors we are asked to wait for.
+ *
+ **************************************/
+	// Forget descriptors not wanted anymore or owned by another port now
+
+	for (FB_SIZE_T i = slct_watched.getCount(); i--;)
+	{
+		const EpollItem& item = slct_watched[i];
+
+		FB_SIZE_T pos;
+		if (slct_wanted.find(item.fd, pos) && slct_wanted[pos].port == item.port)
+			continue;
+
+		// Descriptor could be closed already, then it's removed by the kernel
+		epoll_ctl(slct_epoll, EPOLL_CTL_DEL, item.fd, NULL);
+		unwatch(item.port);
+		slct_watched.remove(i);
+	}
+
+	for (FB_SIZE_T i = slct_polled.getCount(); i--;)
+	{
+		const EpollItem& item = slct_polled[i];
+
+		FB_SIZE_T pos;
+		if (slct_wanted.find(item.fd, pos) && slct_wanted[pos].port == item.port)
+			continue;
+
+		unwatch(item.port);
+		slct_polled.remove(i);
+	}
+
+	// Register new ones
+
+	for (const auto& item : slct_wanted)
+	{
+		FB_SIZE_T pos;
+		if (slct_watched.find(item.fd, pos) || slct_polled.exist(item.fd))
+			continue;
+
+		epoll_event event {};
+		event.events = EPOLLIN;
+		event.data.fd = item.fd;
+
+		if (epoll_ctl(slct_epoll, EPOLL_CTL_ADD, item.fd, &event) != 0 &&
+			(errno != EEXIST || epoll_ctl(slct_epoll, EPOLL_CTL_MOD, item.fd, &event) != 0))
+		{
+			const int error = errno;
+
+			if (error == EBADF || error == ENOENT)
+			{
+				// Bad descriptor, report it as ready to let receive() break the connection.
+				// It's not watched, so its port is found walking all ports and the
+				// registration is retried at the next wait.
+
+				if (!slct_fired.find(item.fd, pos))
+					slct_fired.insert(pos, item.fd);
+
+				slct_scan = true;
+				slct_changed = true;
+				continue;
+			}
+
+			// Out of resources (ENOSPC, ENOMEM) or not supported by epoll (EPERM),
+			// the descriptor is fine though. Wait for it using poll() until its port
+			// is gone.
+
+			gds__log("INET/Select::epollSync: epoll_ctl() failed for descriptor %d, errno = %d, "
+				"poll() is used for it", (int) item.fd, error);
+
+			item.port->addRef();
+			slct_polled.add(item);
+			continue;
+		}
+
+		item.port->addRef();
+		slct_watched.insert(pos, item);
+	}
+}
+
+
+void Select::epollSelect(int milliseconds)
+{
+/**************************************
+ *
+ *	S e l e c t : : e p o l l S e l e c t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Wait for the wanted descriptors to become
+ *	ready using epoll instance.
+ *
+ **************************************/
+	if (slct_sync)
+	{
+		slct_sync = false;
+		epollSync();
+	}
+
+	if (slct_wanted.isEmpty())
+	{
+		errno = NOTASOCKET;
+		slct_count = -1;
+		return;
+	}
+
+	if (slct_fired.hasData())
+	{
+		slct_count = slct_fired.getCount();
+		return;
+	}
+
+	if (slct_polled.hasData())
+	{
+		// Descriptors not registered in epoll instance are polled together with
+		// the epoll instance itself, which is readable when it has some events
+
+		HalfStaticArray<pollfd, 8> fds;
+
+		for (const auto& item : slct_polled)
+		{
+			pollfd& f = fds.add();
+			f.fd = item.fd;
+			f.events = SEL_INIT_EVENTS;
+			f.revents = 0;
+		}
+
+		pollfd& epollFd = fds.add();
+		epollFd.fd = slct_epoll;
+		epollFd.events = POLLIN;
+		epollFd.revents = 0;
+
+		slct_count = ::poll(fds.begin(), fds.getCount(), milliseconds);
+		if (slct_count <= 0)
+			return;
+
+		for (FB_SIZE_T i = 0; i < slct_polled.getCount(); i++)
+		{
+			// Errors and hangups are reported as ready too, receive() will handle them
+			FB_SIZE_T pos;
+			if (fds[i].revents && !slct_fired.find(fds[i].fd, pos))
+				slct_fired.insert(pos, fds[i].fd);
+		}
+
+		if (!(fds.back().revents & POLLIN))
+		{
+			slct_count = slct_fired.getCount();
+			return;
+		}
+
+		milliseconds = 0;
+	}
+
+	// Level-triggered mode is used as the dispatcher reads a single packet from the
+	// ready port and expects to be notified again if something else is pending
+
+	epoll_event events[SEL_MAX_EVENTS];
+	const int count = epoll_wait(slct_epoll, events, SEL_MAX_EVENTS, milliseconds);
+
+	for (int i = 0; i < count; i++)
+	{
+		const SOCKET fd = events[i].data.fd;
+
+		FB_SIZE_T pos;
+		if (!slct_fired.find(fd, pos))
+			slct_fired.insert(pos, fd);
+	}
+
+	slct_count = (count < 0 && slct_fired.isEmpty()) ? count : (int) slct_fired.getCount();
+}
+
+
+Select::HandleState Select::epollNext(RemPortPtr& port)
+{
+/**************************************
+ *
+ *	S e l e c t : : e p o l l N e x t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return the port owning the next descriptor
+ *	reported by epoll, then the next port with
+ *	expired keepalive timer. Ports without events
+ *	are not visited.
+ *
+ **************************************/
+	while (slct_fired.hasData())
+	{
+		const SOCKET fd = slct_fired.pop();
+
+		const EpollItem* const item = findItem(fd);
+		if (!item)
+			continue;
+
+		rem_port* const owner = item->port;
+		if (owner->port_state != rem_port::PENDING || owner->port_handle != fd)
+		{
+			// Port was closed or got another descriptor after registration
+			slct_changed = true;
+			continue;
+		}
+
+		port = owner;
+		return SEL_READY;
+	}
+
+	while (slct_expired.hasData())
+	{
+		const SOCKET fd = slct_expired.pop();
+
+		const EpollItem* const item = findItem(fd);
+		if (item && item->port->port_state == rem_port::PENDING)
+		{
+			port = item->port;
+			return SEL_NO_DATA;
+		}
+	}
+
+	port = nullptr;
+	return SEL_NO_DATA;
+}
+#endif // INET_EPOLL
+
+
 static bool		accept_connection(rem_port*, const P_CNCT*);
 #ifdef HAVE_SETITIMER
 static void		alarm_handler(int);
@@ -562,8 +990,9 @@ static void packet_print(const TEXT*, const UCHAR*, int, ULONG);
 static bool		packet_receive(rem_port*, UCHAR*, SSHORT, SSHORT*);
 static bool		packet_receive2(rem_port*, UCHAR*, SSHORT, SSHORT*);
 static bool		packet_send(rem_port*, const SCHAR*, SSHORT);
+static bool		packet_send_gather(RemoteXdr*, const SCHAR*, ULONG);
 static rem_port*		receive(rem_port*, PACKET *);
-static rem_port*		select_accept(rem_port*);
+static rem_port*		select_accept(rem_port*, rem_port*);
 
 static void		select_port(rem_port*, Select*, RemPortPtr&);
 static bool		select_multi(rem_port*, UCHAR* buffer, SSHORT bufsize, SSHORT* length, RemPortPtr&);
@@ -574,6 +1003,11 @@ static int		send_partial(rem_port*, PACKET *);
 static RemoteXdr*		xdrinet_create(rem_port*, UCHAR *, USHORT, enum xdr_op);
 static bool		setNoNagleOption(rem_port*);
 static bool		setKeepAlive(SOCKET);
+static void		loopback_address(SockAddr&);
+#ifndef WIN_NT
+static bool		local_address(const Config*, sockaddr_un&);
+static rem_port*	local_connect(rem_port*, const TEXT*, PACKET*);
+#endif
 static FPTR_INT	tryStopMainThread = 0;
 
 
@@ -623,6 +1057,10 @@ static rem_port* inet_async_receive = NULL;
 static GlobalPtr<Mutex> port_mutex;
 static GlobalPtr<PortsCleanup>	inet_ports;
 static GlobalPtr<SocketsArray> ports_to_close;
+static rem_port* inet_local_listener = NULL;
+#ifndef WIN_NT
+static GlobalPtr<PathName> inet_local_path;
+#endif
 
 
 rem_port* INET_analyze(ClntAuthBlock* cBlock,
@@ -697,6 +1135,8 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 	// Should compression be tried?
 
 	const bool compression = config && (*config)->getWireCompression();
+	const bool zstd = compression && rem_port::checkCompression(true) &&
+		fb_utils::stricmp((*config)->getWireCompressionCodec(), "zstd") == 0;
 
 	// Establish connection to server
 	// If we want user verification, we can't speak anything less than version 7
@@ -718,7 +1158,8 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 		REMOTE_PROTOCOL(PROTOCOL_VERSION17, ptype_lazy_send, 8),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION18, ptype_lazy_send, 9),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_lazy_send, 10),
-		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_lazy_send, 11)
+		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_lazy_send, 11),
+		REMOTE_PROTOCOL(PROTOCOL_VERSION21, ptype_lazy_send, 12)
 	};
 	static_assert(FB_NELEM(protocols_to_try) <= MAX_CNCT_VERSIONS);
 
@@ -730,6 +1171,8 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 			rem_port::checkCompression())
 		{
 			cnct->p_cnct_versions[i].p_cnct_max_type |= pflag_compress;
+			if (zstd)
+				cnct->p_cnct_versions[i].p_cnct_max_type |= pflag_compress_zstd;
 		}
 	}
 
@@ -842,6 +1285,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 	}
 
 	const bool compress = accept->p_acpt_type & pflag_compress;
+	const bool compressZstd = accept->p_acpt_type & pflag_compress_zstd;
 	accept->p_acpt_type &= ptype_MASK;
 
 	if (accept->p_acpt_type != ptype_out_of_band) {
@@ -854,7 +1298,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 
 	if (compress)
 	{
-		port->initCompression();
+		port->initCompression(compressZstd);
 		port->port_flags |= PORT_compressed;
 	}
 
@@ -903,6 +1347,14 @@ rem_port* INET_connect(const TEXT* name,
 	}
 	REMOTE_get_timeout_params(port, dpb);
 
+#ifndef WIN_NT
+	if (af == AF_UNIX)
+	{
+		fb_assert(packet);
+		return local_connect(port, name, packet);
+	}
+#endif
+
 	string host;
 	string protocol;
 
@@ -1295,6 +1747,98 @@ rem_port* INET_server(SOCKET sock)
 	return port;
 }
 
+#ifndef WIN_NT
+rem_port* INET_local_listener(rem_port* main_port)
+{
+/**************************************
+ *
+ *	I N E T _ l o c a l _ l i s t e n e r
+ *
+ **************************************
+ *
+ * Functional description
+ *	Start listening on the Unix domain socket of the local
+ *	protocol, if it's configured. The listener is linked to
+ *	the main port of the multi-client server, connections
+ *	accepted by it are served exactly as TCP ones.
+ *	Return NULL if the local protocol is not available.
+ *
+ **************************************/
+	sockaddr_un address;
+	if (!local_address(main_port->getPortConfig(), address))
+		return NULL;
+
+	// The socket file may be left by a crashed server.
+	// Remove it unless somebody is still listening on it.
+
+	SOCKET s = os_utils::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (s != INVALID_SOCKET)
+	{
+		const int n = connect(s, (sockaddr*) &address, sizeof(address));
+		const int inetErrNo = INET_ERRNO;
+		SOCLOSE(s);
+
+		if (n == 0)
+		{
+			gds__log("INET/INET_local_listener: socket %s is already in use", address.sun_path);
+			return NULL;
+		}
+
+		if (inetErrNo == ECONNREFUSED)
+		{
+			// Never remove something that is not a stale socket of our own,
+			// the path may point to a file of another user or to a symlink
+
+			struct STAT st;
+			if (os_utils::lstat(address.sun_path, &st) != 0 ||
+				!S_ISSOCK(st.st_mode) || st.st_uid != geteuid())
+			{
+				gds__log("INET/INET_local_listener: %s is not a socket owned by the server, "
+						 "remove it manually", address.sun_path);
+				return NULL;
+			}
+
+			if (unlink(address.sun_path) != 0)
+			{
+				gds__log("INET/INET_local_listener: error %d removing stale socket %s",
+						 INET_ERRNO, address.sun_path);
+				return NULL;
+			}
+		}
+	}
+
+	s = os_utils::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (s == INVALID_SOCKET ||
+		bind(s, (sockaddr*) &address, sizeof(address)) == -1 ||
+		listen(s, SOMAXCONN) == -1)
+	{
+		gds__log("INET/INET_local_listener: error %d listening on socket %s",
+				 INET_ERRNO, address.sun_path);
+		SOCLOSE(s);
+		return NULL;
+	}
+
+	// Local clients may run under any account, like they do with TCP loopback
+	if (chmod(address.sun_path, 0666) == -1)
+		gds__log("INET/INET_local_listener: error %d setting access to socket %s", INET_ERRNO, address.sun_path);
+
+	inet_local_path->assign(address.sun_path);
+
+	rem_port* const port = alloc_port(main_port, PORT_local);
+	port->port_handle = s;
+
+	// Prevent the generation of dummy keepalive packets on the listener port.
+
+	port->port_dummy_packet_interval = 0;
+	port->port_dummy_timeout = 0;
+
+	inet_ports->registerPort(port);
+	inet_local_listener = port;
+
+	return port;
+}
+#endif // !WIN_NT
+
 static bool accept_connection(rem_port* port, const P_CNCT* cnct)
 {
 /**************************************
@@ -1458,6 +2002,7 @@ static rem_port* alloc_port(rem_port* const parent, const USHORT flags)
 	{
 		MutexLockGuard guard(port_mutex, FB_FUNCTION);
 		port->linkParent(parent);
+		INET_select->portsChanged();
 	}
 
 	return port;
@@ -1533,6 +2078,7 @@ static rem_port* aux_connect(rem_port* port, PACKET* packet)
 		SOCLOSE(port->port_channel);
 		port->port_handle = n;
 		port->port_flags |= PORT_async;
+		INET_select->portsChanged();
 
 		get_peer_info(port);
 
@@ -1556,7 +2102,12 @@ static rem_port* aux_connect(rem_port* port, PACKET* packet)
 	// should be configured to be a fixed port number in the server configuration.
 
 	SockAddr address;
-	int status = address.getpeername(port->port_handle);
+	int status = 0;
+	if (port->port_flags & PORT_local)
+		loopback_address(address);
+	else
+		status = address.getpeername(port->port_handle);
+
 	if (status != 0)
 	{
 		const int savedError = INET_ERRNO;
@@ -1611,8 +2162,11 @@ static rem_port* aux_request( rem_port* port, PACKET* packet)
  **************************************/
 
 	// listen on (local) address of the original socket
+	// or on the loopback interface if the client uses the local protocol
 	SockAddr our_address;
-	if (our_address.getsockname(port->port_handle) < 0)
+	if (port->port_flags & PORT_local)
+		loopback_address(our_address);
+	else if (our_address.getsockname(port->port_handle) < 0)
 	{
 		gds__log("INET/aux_request: failed to get local address of the original socket");
 		inet_error(false, port, "getsockname", isc_net_event_listen_err, INET_ERRNO);
@@ -1672,7 +2226,9 @@ static rem_port* aux_request( rem_port* port, PACKET* packet)
 
 	SockAddr port_address;
 
-	if (port_address.getsockname(port->port_handle) < 0)
+	if (port->port_flags & PORT_local)
+		port_address = our_address;
+	else if (port_address.getsockname(port->port_handle) < 0)
 		inet_error(false, port, "getsockname", isc_net_event_listen_err, INET_ERRNO);
 
 	port_address.setPort(our_address.port());
@@ -1787,6 +2343,15 @@ static void disconnect(rem_port* port)
 
 	// If this is a sub-port, unlink it from its parent
 	port->unlinkParent();
+	INET_select->portsChanged();
+
+#ifndef WIN_NT
+	if (port == inet_local_listener)
+	{
+		unlink(inet_local_path->c_str());
+		inet_local_listener = NULL;
+	}
+#endif
 
 	inet_ports->unRegisterPort(port);
 
@@ -1875,6 +2440,14 @@ static int cleanup_ports(const int, const int, void* /*arg*/)
 
 	inet_ports->closePorts();
 
+#ifndef WIN_NT
+	if (inet_local_listener)
+	{
+		unlink(inet_local_path->c_str());
+		inet_local_listener = NULL;
+	}
+#endif
+
 	while (ports_to_close->hasData())
 	{
 		SOCKET s = ports_to_close->pop();
@@ -2092,19 +2665,22 @@ static bool select_multi(rem_port* main_port, UCHAR* buffer, SSHORT bufsize, SSH
 	for (;;)
 	{
 		select_port(main_port, &INET_select, port);
-		if (port == main_port && (port->port_server_flags & SRVR_multi_client))
+		if ((port == main_port || port == inet_local_listener) &&
+			(port->port_server_flags & SRVR_multi_client))
 		{
+			rem_port* const listener = port;
+
 			if (INET_shutting_down)
 			{
-				if (main_port->port_state == rem_port::PENDING)
+				if (listener->port_state == rem_port::PENDING)
 				{
-					main_port->port_state = rem_port::BROKEN;
+					listener->port_state = rem_port::BROKEN;
 
-					shutdown(main_port->port_handle, 2);
-					SOCLOSE(main_port->port_handle);
+					shutdown(listener->port_handle, 2);
+					SOCLOSE(listener->port_handle);
 				}
 			}
-			else if ((port = select_accept(main_port)))
+			else if ((port = select_accept(main_port, listener)))
 			{
 				if (!REMOTE_inflate(port, packet_receive, buffer, bufsize, length))
 				{
@@ -2152,7 +2728,7 @@ static bool select_multi(rem_port* main_port, UCHAR* buffer, SSHORT bufsize, SSH
 	}
 }
 
-static rem_port* select_accept( rem_port* main_port)
+static rem_port* select_accept(rem_port* main_port, rem_port* listener)
 {
 /**************************************
  *
@@ -2161,20 +2737,24 @@ static rem_port* select_accept( rem_port* main_port)
  **************************************
  *
  * Functional description
- *	Accept a new connection request.
+ *	Accept a new connection request coming
+ *	to the TCP or local protocol listener.
  *
  **************************************/
 
 	rem_port* const port = alloc_port(main_port);
 	inet_ports->registerPort(port);
 
-	port->port_handle = os_utils::accept(main_port->port_handle, NULL, NULL);
+	port->port_handle = os_utils::accept(listener->port_handle, NULL, NULL);
 	if (port->port_handle == INVALID_SOCKET)
 	{
 		inet_error(true, port, "accept", isc_net_connect_err, INET_ERRNO);
 	}
 
-	setKeepAlive(port->port_handle);
+	if (listener->port_flags & PORT_local)
+		port->port_flags |= PORT_local;
+	else
+		setKeepAlive(port->port_handle);
 
 	port->port_flags |= PORT_server;
 
@@ -2253,9 +2833,10 @@ static bool select_wait( rem_port* main_port, Select* selct)
  **************************************/
 	bool checkPorts = false;
 
+	const bool epoll = selct->useEpoll();
+
 	for (;;)
 	{
-		selct->clear();
 		bool found = false;
 
 		// Use the time interval between select() calls to expire
@@ -2282,7 +2863,19 @@ static bool select_wait( rem_port* main_port, Select* selct)
 				SOCLOSE(s);
 			}
 
-			for (rem_port* port = main_port; port; port = port->port_next)
+			// With epoll the descriptors remain registered between the waits, thus
+			// ports are walked only when some of them were added or removed or
+			// their keepalive timers should be adjusted, not at every wakeup.
+
+			const bool rescan = selct->checkChanges() || !epoll || checkPorts ||
+				delta_time || INET_shutting_down;
+
+			if (!rescan)
+				found = true;
+			else
+				selct->clear();
+
+			for (rem_port* port = rescan ? main_port : NULL; port; port = port->port_next)
 			{
 				if (port->port_state == rem_port::PENDING &&
 					// don't wait on still listening (not connected) async port
@@ -2293,6 +2886,8 @@ static bool select_wait( rem_port* main_port, Select* selct)
 					if (port->port_dummy_packet_interval)
 					{
 						port->port_dummy_timeout -= delta_time;
+						if (port->port_dummy_timeout < 0)
+							selct->expire(port->port_handle);
 					}
 
 					if (checkPorts)
@@ -2330,9 +2925,9 @@ static bool select_wait( rem_port* main_port, Select* selct)
 					}
 
 					// if process is shuting down - don't listen on main port
-					if (!INET_shutting_down || port != main_port)
+					if (!INET_shutting_down || (port != main_port && port != inet_local_listener))
 					{
-						selct->set(port->port_handle);
+						selct->set(port->port_handle, port);
 						found = true;
 					}
 				}
@@ -2379,7 +2974,7 @@ static bool select_wait( rem_port* main_port, Select* selct)
 				// bit as this value is undefined on some platforms (eg. HP-UX),
 				// when the select call times out. Once these bits are cleared
 				// they can be used in select_port()
-				if (selct->getCount() == 0)
+				if (selct->getCount() == 0 && !epoll)
 				{
 					MutexLockGuard guard(port_mutex, FB_FUNCTION);
 					for (rem_port* port = main_port; port; port = port->port_next)
@@ -2515,6 +3110,13 @@ void get_peer_info(rem_port* port)
 *	Port just connected. Obtain some info about connection and peer.
 *
 **************************************/
+	if (port->port_flags & PORT_local)
+	{
+		// Unix domain socket has no network address
+		port->port_protocol_id = "UNIX";
+		return;
+	}
+
 	port->port_protocol_id = "TCPv4";
 
 	SockAddr address;
@@ -2706,6 +3308,20 @@ bool_t InetXdr::x_putbytes(const SCHAR* buff, unsigned bytecount)
  *
  **************************************/
 
+	// Bulk data not fitting into the buffer is sent directly from the
+	// caller's memory, together with the data buffered so far.
+
+	if (bytecount > x_handy && bytecount >= INET_remote_buffer)
+	{
+		const rem_port* port = x_public;
+
+		if (!(port->port_flags & (PORT_compressed | PORT_async)) &&
+			!(port->port_crypt_plugin && port->port_crypt_complete))
+		{
+			return packet_send_gather(this, buff, bytecount);
+		}
+	}
+
 	// Use memcpy to optimize bulk transfers.
 
 	while (bytecount > sizeof(ISC_QUAD))
@@ -3308,6 +3924,91 @@ static bool packet_send( rem_port* port, const SCHAR* buffer, SSHORT buffer_leng
 	return true;
 }
 
+static bool packet_send_gather(RemoteXdr* xdrs, const SCHAR* buffer, ULONG buffer_length)
+{
+/**************************************
+ *
+ *	p a c k e t _ s e n d _ g a t h e r
+ *
+ **************************************
+ *
+ * Functional description
+ *	Send the contents of XDR buffer followed by the
+ *	caller's data with a single vectored write, avoiding
+ *	copy of the data into XDR buffer.
+ *
+ **************************************/
+	rem_port* port = xdrs->x_public;
+
+	const char* head = xdrs->x_base;
+	ULONG head_length = xdrs->x_private - xdrs->x_base;
+
+	port->bumpLogBytes(rem_port::SEND, head_length + buffer_length);
+
+	while (head_length || buffer_length)
+	{
+#ifdef WIN_NT
+		WSABUF bufs[2];
+		bufs[0].buf = const_cast<char*>(head);
+		bufs[0].len = head_length;
+		bufs[1].buf = const_cast<char*>(buffer);
+		bufs[1].len = buffer_length;
+
+		DWORD sent = 0;
+		const int n = WSASend(port->port_handle, head_length ? bufs : bufs + 1,
+			head_length ? 2 : 1, &sent, 0, NULL, NULL) ? -1 : (int) sent;
+#else
+		iovec iov[2];
+		iov[0].iov_base = const_cast<char*>(head);
+		iov[0].iov_len = head_length;
+		iov[1].iov_base = const_cast<char*>(buffer);
+		iov[1].iov_len = buffer_length;
+
+		msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = head_length ? iov : iov + 1;
+		msg.msg_iovlen = head_length ? 2 : 1;
+
+		const ssize_t n = sendmsg(port->port_handle, &msg, FB_SEND_FLAGS);
+#endif
+
+		if (n == -1)
+		{
+			if (INTERRUPT_ERROR(INET_ERRNO)) {
+				continue;
+			}
+
+			try
+			{
+				inet_error(false, port, "sendmsg", isc_net_write_err, INET_ERRNO);
+			}
+			catch (const Exception&) { }
+			return false;
+		}
+
+		port->bumpPhysStats(rem_port::SEND, n);
+
+		ULONG done = (ULONG) n;
+		if (done >= head_length)
+		{
+			done -= head_length;
+			head_length = 0;
+			buffer += done;
+			buffer_length -= done;
+		}
+		else
+		{
+			head += done;
+			head_length -= done;
+		}
+	}
+
+	xdrs->x_private = xdrs->x_base;
+	xdrs->x_handy = INET_remote_buffer;
+
+	return true;
+}
+
 static bool setNoNagleOption(rem_port* port)
 {
 /**************************************
@@ -3354,6 +4055,105 @@ static bool setKeepAlive(SOCKET s)
 	return n != -1;
 }
 
+static void loopback_address(SockAddr& address)
+{
+/**************************************
+ *
+ *      l o o p b a c k _ a d d r e s s
+ *
+ **************************************
+ *
+ * Functional description
+ *      Set IPv4 loopback address, used for the
+ *		events channel of the local protocol.
+ *
+ **************************************/
+	sockaddr_in loopback {};
+	loopback.sin_family = AF_INET;
+	loopback.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	address = SockAddr((const unsigned char*) &loopback, sizeof(loopback));
+}
+
+#ifndef WIN_NT
+static bool local_address(const Config* config, sockaddr_un& address)
+{
+/**************************************
+ *
+ *      l o c a l _ a d d r e s s
+ *
+ **************************************
+ *
+ * Functional description
+ *      Build the address of the Unix domain socket of
+ *		the local protocol. Relative socket name is placed
+ *		into the lock directory. Return false if the local
+ *		protocol is not configured.
+ *
+ **************************************/
+	const char* const name = config->getLocalSocketName();
+	if (!name || !name[0])
+		return false;
+
+	TEXT path[MAXPATHLEN];
+	if (name[0] == '/')
+		fb_utils::copy_terminate(path, name, sizeof(path));
+	else
+		gds__prefix_lock(path, name);
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if (strlen(path) >= sizeof(address.sun_path))
+	{
+		gds__log("INET/local_address: socket name %s is too long", path);
+		return false;
+	}
+
+	strcpy(address.sun_path, path);
+	return true;
+}
+
+static rem_port* local_connect(rem_port* port, const TEXT* name, PACKET* packet)
+{
+/**************************************
+ *
+ *      l o c a l _ c o n n e c t
+ *
+ **************************************
+ *
+ * Functional description
+ *      Client part of INET_connect() for the local
+ *		protocol: connect to the Unix domain socket of
+ *		the server and send the connect packet.
+ *
+ **************************************/
+	sockaddr_un address;
+	if (!local_address(port->getPortConfig(), address))
+	{
+		inet_gen_error(true, port, Arg::Gds(isc_net_connect_err) <<
+			Arg::Gds(isc_random) << "Local protocol is not configured, see LocalSocketName");
+	}
+
+	port->port_flags |= PORT_local;
+	port->port_handle = os_utils::socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (port->port_handle == INVALID_SOCKET)
+		inet_error(true, port, "socket", isc_net_connect_err, INET_ERRNO);
+
+	if (connect(port->port_handle, (sockaddr*) &address, sizeof(address)) == -1)
+		inet_error(true, port, "connect", isc_net_connect_err, INET_ERRNO);
+
+	port->port_peer_name = name;
+	get_peer_info(port);
+
+	if (!send_full(port, packet))
+		inet_error(true, port, "connect", isc_net_connect_err, 0);
+
+	return port;
+}
+#endif // !WIN_NT
+
 void setStopMainThread(FPTR_INT func)
 {
 /**************************************
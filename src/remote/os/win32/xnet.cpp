@@ -309,7 +309,8 @@ rem_port* XNET_analyze(ClntAuthBlock* cBlock,
 		REMOTE_PROTOCOL(PROTOCOL_VERSION17, ptype_batch_send, 8),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION18, ptype_batch_send, 9),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_batch_send, 10),
-		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_batch_send, 11)
+		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_batch_send, 11),
+		REMOTE_PROTOCOL(PROTOCOL_VERSION21, ptype_batch_send, 12)
 	};
 	static_assert(FB_NELEM(protocols_to_try) <= MAX_CNCT_VERSIONS);
 
@@ -1657,6 +1657,10 @@ static bool_t xdr_packed_message( RemoteXdr* xdrs, RMessage* message, const rem_
 		}
 	};
 
+	// Since protocol 21 items are sent without XDR alignment and padding
+
+	const bool compact = (port->port_protocol >= PROTOCOL_COMPACT_MESSAGE);
+
 	fb_assert(format->fmt_desc.getCount() % 2 == 0);
 	const USHORT flagBytes = (format->fmt_desc.getCount() / 2 + 7) / 8;
 	NullBitmap nulls(flagBytes);
@@ -1678,8 +1682,11 @@ static bool_t xdr_packed_message( RemoteXdr* xdrs, RMessage* message, const rem_
 
 		// Send the NULL bitmap
 
-		if (!xdr_opaque(xdrs, reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes))
+		if (!(compact ? xdrs->x_putbytes(reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes) :
+				xdr_opaque(xdrs, reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes)))
+		{
 			return FALSE;
+		}
 
 		// Second pass (even elements): process non-NULL items
 
@@ -1690,8 +1697,11 @@ static bool_t xdr_packed_message( RemoteXdr* xdrs, RMessage* message, const rem_
 
 			if (!nulls.isNull(index))
 			{
-				if (!xdr_datum(xdrs, desc, message->msg_address))
+				if (!(compact ? xdr_compact_datum(xdrs, desc, message->msg_address) :
+						xdr_datum(xdrs, desc, message->msg_address)))
+				{
 					return FALSE;
+				}
 			}
 		}
 	}
@@ -1703,8 +1713,11 @@ static bool_t xdr_packed_message( RemoteXdr* xdrs, RMessage* message, const rem_
 
 		// Receive the NULL bitmap
 
-		if (!xdr_opaque(xdrs, reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes))
+		if (!(compact ? xdrs->x_getbytes(reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes) :
+				xdr_opaque(xdrs, reinterpret_cast<SCHAR*>(nulls.getData()), flagBytes)))
+		{
 			return FALSE;
+		}
 
 		// First pass (odd elements): initialize NULL indicators
 
@@ -1726,8 +1739,11 @@ static bool_t xdr_packed_message( RemoteXdr* xdrs, RMessage* message, const rem_
 
 			if (!nulls.isNull(index))
 			{
-				if (!xdr_datum(xdrs, desc, message->msg_address))
+				if (!(compact ? xdr_compact_datum(xdrs, desc, message->msg_address) :
+						xdr_datum(xdrs, desc, message->msg_address)))
+				{
 					return FALSE;
+				}
 			}
 		}
 	}
@@ -119,6 +119,12 @@ constexpr USHORT PROTOCOL_INLINE_BLOB = PROTOCOL_VERSION19;
 constexpr USHORT PROTOCOL_VERSION20 = (FB_PROTOCOL_FLAG | 20);
 constexpr USHORT PROTOCOL_PREPARE_FLAG = PROTOCOL_VERSION20;
 
+// Protocol 21:
+//	- packed messages use compact (unaligned, variable length) encoding of items
+
+constexpr USHORT PROTOCOL_VERSION21 = (FB_PROTOCOL_FLAG | 21);
+constexpr USHORT PROTOCOL_COMPACT_MESSAGE = PROTOCOL_VERSION21;
+
 // Architecture types
 
 enum P_ARCH
@@ -154,6 +160,7 @@ constexpr USHORT ptype_MASK			= 0xFF;	// Mask - up to 255 types of protocol
 // upper byte is used for protocol flags
 constexpr USHORT pflag_compress			= 0x100;	// Turn on compression if possible
 constexpr USHORT pflag_win_sspi_nego	= 0x200;	// Win_SSPI supports Negotiate security package
+constexpr USHORT pflag_compress_zstd	= 0x400;	// Zstandard is used for compression
 
 // Generic object id
 
@@ -386,8 +393,9 @@ typedef struct p_malloc
 
 // Connect Block (Client to server)
 
-// Servers before FB6 (PROTOCOL_VERSION20) uses only first 10 elements of p_cnct_versions
-constexpr size_t MAX_CNCT_VERSIONS = 11;
+// Servers before FB6 (PROTOCOL_VERSION20) uses only first 10 elements of p_cnct_versions,
+// servers supporting PROTOCOL_VERSION20 - first 11 elements
+constexpr size_t MAX_CNCT_VERSIONS = 12;
 
 typedef struct p_cnct
 {
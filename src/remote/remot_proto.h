@@ -56,6 +56,7 @@ enum LegacyPlugin {PLUGIN_NEW = 0, PLUGIN_LEGACY, PLUGIN_TRUSTED};
 
 void		REMOTE_cleanup_transaction (struct Rtr *);
 USHORT		REMOTE_compute_batch_size (rem_port*, USHORT, P_OP, const rem_fmt*);
+USHORT		REMOTE_fetch_batch_size (rem_port*, const rem_fmt*, USHORT);
 void		REMOTE_get_timeout_params(rem_port* port, Firebird::ClumpletReader* pb);
 struct Rrq*	REMOTE_find_request (struct Rrq *, USHORT);
 void		REMOTE_free_packet (rem_port*, struct packet *, bool = false);
@@ -251,6 +251,34 @@ USHORT REMOTE_compute_batch_size(rem_port* port,
 }
 
 
+USHORT REMOTE_fetch_batch_size(rem_port* port, const rem_fmt* format, USHORT rows)
+{
+/**************************************
+ *
+ *	R E M O T E _ f e t c h _ b a t c h _ s i z e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Compute the number of rows to request by op_fetch.
+ *	The default batch size is used unless the client has
+ *	grown it (see rows) from the measured time it waited
+ *	for rows compared to the time it spent consuming them,
+ *	i.e. the batch was too small to hide the network round
+ *	trip. Grown batch is limited by the fetch window size.
+ *
+ **************************************/
+	const USHORT batch = REMOTE_compute_batch_size(port, 0, op_fetch_response, format);
+
+	if (rows <= batch)
+		return batch;
+
+	const ULONG limit = MIN(MAX_FETCH_WINDOW / format->fmt_length, (ULONG) MAX_USHORT);
+
+	return static_cast<USHORT>(MAX(MIN((ULONG) rows, limit), (ULONG) batch));
+}
+
+
 Rrq* REMOTE_find_request(Rrq* request, USHORT level)
 {
 /**************************************
@@ -682,6 +710,7 @@ void rem_port::abort_aux_connection()
 
 XDR_INT rem_port::send(PACKET* pckt)
 {
+	port_resp_deferred = false;
 	return (*this->port_send_packet)(this, pckt);
 }
 
@@ -1519,6 +1548,56 @@ void rem_port::versionInfo(string& version) const
 
 #ifdef WIRE_COMPRESS_SUPPORT
 static InitInstance<ZLib> zlib;
+static InitInstance<ZStd> zstd;
+
+static bool inflateStream(rem_port* port, z_stream& strm)
+{
+	if (!port->port_zstd_recv)
+		return zlib().inflate(&strm, Z_NO_FLUSH) == Z_OK;
+
+	ZStd::InBuffer in = {strm.next_in, strm.avail_in, 0};
+	ZStd::OutBuffer out = {strm.next_out, strm.avail_out, 0};
+
+	const size_t ret = zstd().ZSTD_decompressStream(port->port_zstd_recv, &out, &in);
+
+	strm.next_in += in.pos;
+	strm.avail_in -= in.pos;
+	strm.next_out += out.pos;
+	strm.avail_out -= out.pos;
+
+	return !zstd().ZSTD_isError(ret);
+}
+
+static int deflateStream(rem_port* port, z_stream& strm, bool flush)
+{
+	if (!port->port_zstd_send)
+	{
+		const int ret = zlib().deflate(&strm, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+		return (ret == Z_BUF_ERROR) ? Z_OK : ret;
+	}
+
+	ZStd::InBuffer in = {strm.next_in, strm.avail_in, 0};
+	ZStd::OutBuffer out = {strm.next_out, strm.avail_out, 0};
+
+	const size_t ret = zstd().ZSTD_compressStream2(port->port_zstd_send, &out, &in,
+		flush ? ZStd::E_FLUSH : ZStd::E_CONTINUE);
+
+	strm.next_in += in.pos;
+	strm.avail_in -= in.pos;
+	strm.next_out += out.pos;
+	strm.avail_out -= out.pos;
+
+	return zstd().ZSTD_isError(ret) ? Z_STREAM_ERROR : Z_OK;
+}
+
+// Valid compression level for the codec, 0 (default level) if out of range
+static int compressionLevel(int level, bool zstdCodec)
+{
+	const int minLevel = zstdCodec ? -7 : Z_BEST_SPEED;
+	const int maxLevel = zstdCodec ? 22 : Z_BEST_COMPRESSION;
+
+	return (level >= minLevel && level <= maxLevel) ? level : 0;
+}
 #endif // WIRE_COMPRESS_SUPPORT
 
 rem_port::~rem_port()
@@ -1547,7 +1626,12 @@ rem_port::~rem_port()
 #endif
 
 #ifdef WIRE_COMPRESS_SUPPORT
-	if (port_compressed)
+	if (port_zstd_send)
+	{
+		zstd().ZSTD_freeCCtx(port_zstd_send);
+		zstd().ZSTD_freeDCtx(port_zstd_recv);
+	}
+	else if (port_compressed)
 	{
 		zlib().deflateEnd(&port_send_stream);
 		zlib().inflateEnd(&port_recv_stream);
@@ -1573,7 +1657,9 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 
 	for (;;)
 	{
-		if (strm.avail_in)
+		// zstd may keep decompressed data inside after the input is consumed,
+		// flush it with empty input before waiting for more data from the wire
+		if (strm.avail_in || port->port_zstd_recv)
 		{
 #ifdef COMPRESS_DEBUG
 			fprintf(stderr, "Data to inflate %d port %p\n", strm.avail_in, port);
@@ -1583,7 +1669,7 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 #endif
 #endif
 
-			if (zlib().inflate(&strm, Z_NO_FLUSH) != Z_OK)
+			if (!inflateStream(port, strm))
 			{
 #ifdef COMPRESS_DEBUG
 				fprintf(stderr, "Inflate error\n");
@@ -1628,7 +1714,10 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 	}
 
 	*length = (SSHORT) (buffer_length - strm.avail_out);
-	if (strm.avail_in)	// Z-buffer still has some data - probably can call inflate() once more on them
+
+	// Z-buffer still has some data - probably can call inflate() once more on them.
+	// zstd may also keep decompressed data inside when output buffer is full.
+	if (strm.avail_in || (port->port_zstd_recv && !strm.avail_out))
 		port->port_z_data = true;
 	else
 		port->port_z_data = false;
@@ -1677,10 +1766,8 @@ bool REMOTE_deflate(RemoteXdr* xdrs, ProtoWrite* proto_write, PacketSend* packet
 		fprintf(stderr, "\n");
 #endif
 #endif
-		int ret = zlib().deflate(&strm, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
-		if (ret == Z_BUF_ERROR)
-			ret = 0;
-		if (ret != 0)
+		const int ret = deflateStream(port, strm, flush);
+		if (ret != Z_OK)
 		{
 #ifdef COMPRESS_DEBUG
 			fprintf(stderr, "Deflate error %d\n", ret);
@@ -1723,52 +1810,87 @@ bool REMOTE_deflate(RemoteXdr* xdrs, ProtoWrite* proto_write, PacketSend* packet
 #endif
 }
 
-bool rem_port::checkCompression()
+bool rem_port::checkCompression(bool zstdCodec)
 {
 #ifdef WIRE_COMPRESS_SUPPORT
-	return zlib();
+	return zstdCodec ? zstd() : zlib();
 #else
 	return false;
 #endif
 }
 
-void rem_port::initCompression()
+void rem_port::initCompression(bool zstdCodec)
 {
 #ifdef WIRE_COMPRESS_SUPPORT
-	if (port_protocol >= PROTOCOL_VERSION13 && !port_compressed && zlib())
+	if (port_protocol >= PROTOCOL_VERSION13 && !port_compressed && (zstdCodec ? zstd() : zlib()))
 	{
-		port_send_stream.zalloc = ZLib::allocFunc;
-		port_send_stream.zfree = ZLib::freeFunc;
-		port_send_stream.opaque = Z_NULL;
-		int ret = zlib().deflateInit(&port_send_stream, Z_DEFAULT_COMPRESSION);
-		if (ret != Z_OK)
-			(Arg::Gds(isc_deflate_init) << Arg::Num(ret)).raise();
-		port_send_stream.next_out = NULL;
+		const int level = compressionLevel(getPortConfig()->getWireCompressionLevel(), zstdCodec);
 
-		port_recv_stream.zalloc = ZLib::allocFunc;
-		port_recv_stream.zfree = ZLib::freeFunc;
-		port_recv_stream.opaque = Z_NULL;
-		port_recv_stream.avail_in = 0;
-		port_recv_stream.next_in = Z_NULL;
-		ret = zlib().inflateInit(&port_recv_stream);
-		if (ret != Z_OK)
+		if (zstdCodec)
 		{
-			zlib().deflateEnd(&port_send_stream);
-			(Arg::Gds(isc_inflate_init) << Arg::Num(ret)).raise();
+			port_zstd_send = zstd().ZSTD_createCCtx();
+			port_zstd_recv = zstd().ZSTD_createDCtx();
+
+			if (!port_zstd_send || !port_zstd_recv ||
+				(level && zstd().ZSTD_isError(zstd().ZSTD_CCtx_setParameter(port_zstd_send,
+					ZStd::C_COMPRESSION_LEVEL, level))))
+			{
+				if (port_zstd_send)
+					zstd().ZSTD_freeCCtx(port_zstd_send);
+				if (port_zstd_recv)
+					zstd().ZSTD_freeDCtx(port_zstd_recv);
+				port_zstd_send = NULL;
+				port_zstd_recv = NULL;
+				(Arg::Gds(isc_deflate_init) << Arg::Num(Z_STREAM_ERROR)).raise();
+			}
+		}
+		else
+		{
+			port_send_stream.zalloc = ZLib::allocFunc;
+			port_send_stream.zfree = ZLib::freeFunc;
+			port_send_stream.opaque = Z_NULL;
+			int ret = zlib().deflateInit(&port_send_stream, level ? level : Z_DEFAULT_COMPRESSION);
+			if (ret != Z_OK)
+				(Arg::Gds(isc_deflate_init) << Arg::Num(ret)).raise();
+
+			port_recv_stream.zalloc = ZLib::allocFunc;
+			port_recv_stream.zfree = ZLib::freeFunc;
+			port_recv_stream.opaque = Z_NULL;
+			port_recv_stream.avail_in = 0;
+			port_recv_stream.next_in = Z_NULL;
+			ret = zlib().inflateInit(&port_recv_stream);
+			if (ret != Z_OK)
+			{
+				zlib().deflateEnd(&port_send_stream);
+				(Arg::Gds(isc_inflate_init) << Arg::Num(ret)).raise();
+			}
 		}
 
+		port_send_stream.next_out = NULL;
+
 		try
 		{
 			port_compressed.reset(FB_NEW_POOL(getPool()) UCHAR[port_buff_size * 2]);
 		}
 		catch (const Exception&)
 		{
-			zlib().deflateEnd(&port_send_stream);
-			zlib().inflateEnd(&port_recv_stream);
+			if (zstdCodec)
+			{
+				zstd().ZSTD_freeCCtx(port_zstd_send);
+				zstd().ZSTD_freeDCtx(port_zstd_recv);
+				port_zstd_send = NULL;
+				port_zstd_recv = NULL;
+			}
+			else
+			{
+				zlib().deflateEnd(&port_send_stream);
+				zlib().inflateEnd(&port_recv_stream);
+			}
 			throw;
 		}
 
 		memset(port_compressed, 0, port_buff_size * 2);
+		port_recv_stream.avail_in = 0;
 		port_recv_stream.next_in = &port_compressed[REM_RECV_OFFSET(port_buff_size)];
 
 #ifdef COMPRESS_DEBUG
@@ -89,6 +89,7 @@ DEFINE_TRACE_ROUTINE(remote_trace);
 #endif
 
 constexpr int BLOB_LENGTH = 16384;
+constexpr int BLOB_STREAM_LENGTH = MAX_USHORT - 1;	// chunk size for sequential read of a big blob
 
 #include "../remote/protocol.h"
 #include "fb_blk.h"
@@ -102,6 +103,10 @@ constexpr ULONG MAX_ROWS_PER_BATCH = 1000;
 
 constexpr ULONG MAX_BATCH_CACHE_SIZE = 1024 * 1024; // 1 MB
 
+// Limit for adaptively grown fetch batches, both for the rows requested
+// by the client and for the data sent by the server in one batch
+constexpr ULONG MAX_FETCH_WINDOW = 4 * 1024 * 1024; // 4 MB
+
 constexpr ULONG	DEFAULT_BLOBS_CACHE_SIZE = 10 * 1024 * 1024;	// 10 MB
 
 constexpr ULONG	MAX_INLINE_BLOB_SIZE = MAX_USHORT;
@@ -371,6 +376,7 @@ class RemBlobBuffer : public Firebird::Array<UCHAR>
 struct Rbl : public Firebird::GlobalStorage, public TypedHandle<rem_type_rbl>
 {
 	RemBlobBuffer	rbl_data;
+	RemBlobBuffer	rbl_ahead;		// next chunk of blob read in advance
 	Rdb*		rbl_rdb;
 	Rtr*		rbl_rtr;
 	UCHAR*		rbl_buffer;
@@ -383,6 +389,8 @@ struct Rbl : public Firebird::GlobalStorage, public TypedHandle<rem_type_rbl>
 	USHORT		rbl_buffer_length;
 	USHORT		rbl_length;
 	USHORT		rbl_fragment_length;
+	USHORT		rbl_ahead_length;
+	USHORT		rbl_ahead_object;	// p_resp_object of read-ahead response
 	USHORT		rbl_source_interp;	// source interp (for writing)
 	USHORT		rbl_target_interp;	// destination interp (for reading)
 	Rbl**		rbl_self;
@@ -397,14 +405,17 @@ public:
 		CREATE = 0x08,
 		CACHED = 0x10,			// Blob is fully cached
 		USED = 0x20,			// Cached blob is in use by application
+		READ_AHEAD = 0x40,		// op_get_segment for the next chunk is sent, response is pending
+		AHEAD_READY = 0x80		// next chunk is received into rbl_ahead
 	};
 
 public:
 	Rbl(unsigned int initialSize) :
-		rbl_data(getPool()), rbl_rdb(0), rbl_rtr(0),
+		rbl_data(getPool()), rbl_ahead(getPool()), rbl_rdb(0), rbl_rtr(0),
 		rbl_buffer(rbl_data.getBuffer(initialSize)), rbl_ptr(rbl_buffer), rbl_iface(NULL),
 		rbl_blob_id(NULL_BLOB), rbl_offset(0), rbl_id(0), rbl_flags(0),
 		rbl_buffer_length(initialSize), rbl_length(0), rbl_fragment_length(0),
+		rbl_ahead_length(0), rbl_ahead_object(0),
 		rbl_source_interp(0), rbl_target_interp(0), rbl_self(NULL)
 	{ }
 
@@ -665,6 +676,12 @@ struct Rsr : public Firebird::GlobalStorage, public TypedHandle<rem_type_rsr>
 	USHORT			rsr_msgs_waiting; 	// count of full rsr_messages
 	USHORT			rsr_reorder_level; 	// Trigger pipelining at this level
 	USHORT			rsr_batch_count; 	// Count of batches in pipeline
+	USHORT			rsr_fetch_rows;		// Rows requested by the last batch, adjusted by timings below
+	ULONG			rsr_fetch_consumed;	// Rows returned to the client since the last batch request
+	ULONG			rsr_fetch_total;	// Rows returned to the client since the first fetch
+	SINT64			rsr_fetch_clock;	// When the last row was returned to the client
+	SINT64			rsr_consume_time;	// Time spent by the client between fetches since the last batch request
+	SINT64			rsr_wait_time;		// Time spent by the client waiting for rows since the last batch request
 
 	Firebird::string rsr_cursor_name;	// Name for cursor to be set on open
 	bool			rsr_delayed_format;	// Out format was delayed on execute, set it on fetch
@@ -734,6 +751,8 @@ public:
 		rsr_format(0), rsr_message(0), rsr_buffer(0), rsr_status(0),
 		rsr_id(0), rsr_fmt_length(0),
 		rsr_rows_pending(0), rsr_msgs_waiting(0), rsr_reorder_level(0), rsr_batch_count(0),
+		rsr_fetch_rows(0), rsr_fetch_consumed(0), rsr_fetch_total(0),
+		rsr_fetch_clock(0), rsr_consume_time(0), rsr_wait_time(0),
 		rsr_cursor_name(getPool()), rsr_delayed_format(false), rsr_timeout(0), rsr_self(NULL),
 		rsr_batch_size(0), rsr_batch_flags(0), rsr_batch_ics(NULL),
 		rsr_fetch_operation(fetch_next), rsr_fetch_position(0), rsr_inline_blob_size(0)
@@ -1254,6 +1273,7 @@ constexpr USHORT PORT_connecting	= 0x0400;	// Aux connection waits for a channel
 //constexpr USHORT PORT_z_data		= 0x0800;	// Zlib incoming buffer has data left after decompression
 constexpr USHORT PORT_compressed	= 0x1000;	// Compress outgoing stream (does not affect incoming)
 constexpr USHORT PORT_released		= 0x2000;	// release(), complementary to the first addRef() in constructor, was called
+constexpr USHORT PORT_local			= 0x4000;	// Unix domain socket of the local protocol
 
 // forward decl
 class RemotePortGuard;
@@ -1311,6 +1331,7 @@ struct rem_port : public Firebird::GlobalStorage, public Firebird::RefCounted
 	std::atomic<bool>
 					port_partial_data,	// Physical packet doesn't contain all API packet
 					port_z_data;		// Zlib incoming buffer has data left after decompression
+	bool			port_resp_deferred;	// Response is kept in send buffer until next reply, see send_response()
 	SLONG			port_connect_timeout;   // Connection timeout value
 	SLONG			port_dummy_packet_interval; // keep alive dummy packet interval
 	SLONG			port_dummy_timeout;	// time remaining until keepalive packet
@@ -1467,6 +1488,10 @@ public:
 #ifdef WIRE_COMPRESS_SUPPORT
 	z_stream port_send_stream, port_recv_stream;
 	UCharArrayAutoPtr	port_compressed;
+	// zstd streams, replace zlib ones when zstd is negotiated. Buffer
+	// positions are tracked in z_stream fields for both codecs.
+	Firebird::ZStd::CCtx* port_zstd_send = nullptr;
+	Firebird::ZStd::DCtx* port_zstd_recv = nullptr;
 #endif
 
 public:
@@ -1480,7 +1505,7 @@ public:
 		port_type(t), port_state(PENDING), port_clients(0), port_next(0),
 		port_parent(0), port_async(0), port_async_receive(0),
 		port_server(0), port_server_flags(0), port_protocol(0), port_buff_size((USHORT)(rpt / 2)),
-		port_flags(0), port_partial_data(false), port_z_data(false),
+		port_flags(0), port_partial_data(false), port_z_data(false), port_resp_deferred(false),
 		port_connect_timeout(0), port_dummy_packet_interval(0),
 		port_dummy_timeout(0), port_handle(INVALID_SOCKET), port_channel(INVALID_SOCKET), port_context(0),
 		port_events_thread(0), port_thread_guard(0),
@@ -1526,8 +1551,8 @@ private:
 	friend class Firebird::RefPtr<rem_port>;
 
 public:
-	void initCompression();
-	static bool checkCompression();
+	void initCompression(bool zstd = false);
+	static bool checkCompression(bool zstd = false);
 	void linkParent(rem_port* const parent);
 	void unlinkParent();
 	Firebird::RefPtr<const Firebird::Config> getPortConfig();
@@ -473,6 +473,10 @@ int CLIB_ROUTINE main( int argc, char** argv)
 			try
 			{
 				port = INET_connect(protocol, 0, INET_SERVER_flag, 0, NULL);
+
+				// Local protocol is served by the multi-client server only
+				if (port && (INET_SERVER_flag & SRVR_multi_client))
+					INET_local_listener(port);
 			}
 			catch (const Exception& ex)
 			{
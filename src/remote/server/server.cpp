@@ -796,7 +796,7 @@ public:
 				}
 
 				if (send->p_acpt.p_acpt_type & pflag_compress)
-					authPort->initCompression();
+					authPort->initCompression(send->p_acpt.p_acpt_type & pflag_compress_zstd);
 				authPort->send(send);
 				if (send->p_acpt.p_acpt_type & pflag_compress)
 					authPort->port_flags |= PORT_compressed;
@@ -1295,6 +1295,7 @@ static void		set_server(rem_port*, USHORT);
 static int		shut_server(const int, const int, void*);
 static int		pre_shutdown(const int, const int, void*);
 static THREAD_ENTRY_DECLARE loopThread(THREAD_ENTRY_PARAM);
+static THREAD_ENTRY_DECLARE stallThread(THREAD_ENTRY_PARAM);
 static void		zap_packet(PACKET*, bool);
 
 
@@ -1319,8 +1320,8 @@ inline bool bad_service(IStatus* status_vector, Rdb* rdb)
 class Worker
 {
 public:
-	static const int MAX_THREADS = MAX_SLONG;
 	static const int IDLE_TIMEOUT = 60;
+	static const int STALL_TIMEOUT = 5;	// no request was dequeued by busy workers for that long
 
 	Worker();
 	~Worker();
@@ -1336,6 +1337,7 @@ public:
 	static bool isShuttingDown() { return shutting_down; }
 
 	static void shutdown();
+	static void watchStalls();
 
 private:
 	Worker* m_next;
@@ -1350,6 +1352,9 @@ private:
 	void remove();
 	void insert(const bool active);
 	static void wakeUpAll();
+	static int maxThreads();
+	static bool startThread();
+	static void limitReached();
 
 	static Worker* m_activeWorkers;
 	static Worker* m_idleWorkers;
@@ -1358,6 +1363,11 @@ private:
 	static int m_cntIdle;
 	static int m_cntGoing;
 	static bool shutting_down;
+	static USHORT m_flags;
+	static bool m_limitLogged;
+	static bool m_watching;
+	static Thread::Handle m_watchHandle;
+	static GlobalPtr<Semaphore> m_watchSem;
 };
 
 Worker* Worker::m_activeWorkers = NULL;
@@ -1367,6 +1377,11 @@ int Worker::m_cntAll = 0;
 int Worker::m_cntIdle = 0;
 int Worker::m_cntGoing = 0;
 bool Worker::shutting_down = false;
+USHORT Worker::m_flags = 0;
+bool Worker::m_limitLogged = false;
+bool Worker::m_watching = false;
+Thread::Handle Worker::m_watchHandle = 0;
+GlobalPtr<Semaphore> Worker::m_watchSem;
 
 
 static GlobalPtr<Mutex> request_que_mutex;
@@ -1375,6 +1390,7 @@ static server_req_t* free_requests		= NULL;
 static server_req_t* active_requests	= NULL;
 static int ports_active					= 0;	// length of active_requests
 static int ports_pending				= 0;	// length of request_que
+static FB_UINT64 requests_dequeued		= 0;	// requests taken from request_que by workers
 
 static GlobalPtr<Mutex> servers_mutex;
 static srvr* servers = NULL;
@@ -1923,7 +1939,8 @@ void SRVR_multi_thread( rem_port* main_port, USHORT flags)
 
 bool wireEncryption(rem_port* port, ClumpletReader& id)
 {
-	if (port->port_type == rem_port::XNET)		// local connection
+	if (port->port_type == rem_port::XNET ||	// local connection
+		(port->port_flags & PORT_local))
 	{
 		port->port_crypt_level = WIRECRYPT_DISABLED;
 		return false;
@@ -2010,6 +2027,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	USHORT version = 0;
 	USHORT type = 0;
 	bool compress = false;
+	bool zstd = false;
 	bool accepted = false;
 	USHORT weight = 0;
 	const p_cnct::p_cnct_repeat* protocol = connect->p_cnct_versions;
@@ -2019,7 +2037,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	{
 		if ((protocol->p_cnct_version == PROTOCOL_VERSION10 ||
 			 (protocol->p_cnct_version >= PROTOCOL_VERSION11 &&
-			  protocol->p_cnct_version <= PROTOCOL_VERSION20)) &&
+			  protocol->p_cnct_version <= PROTOCOL_VERSION21)) &&
 			 (protocol->p_cnct_architecture == arch_generic ||
 			  protocol->p_cnct_architecture == ARCHITECTURE) &&
 			protocol->p_cnct_weight >= weight)
@@ -2030,6 +2048,8 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 			architecture = protocol->p_cnct_architecture;
 			type = MIN(protocol->p_cnct_max_type & ptype_MASK, ptype_lazy_send);
 			compress = protocol->p_cnct_max_type & pflag_compress;
+			zstd = compress && (protocol->p_cnct_max_type & pflag_compress_zstd) &&
+				rem_port::checkCompression(true);
 		}
 	}
 
@@ -2038,7 +2058,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_acpd.p_acpt_version = port->port_protocol = version;
 	send->p_acpd.p_acpt_architecture = architecture;
-	send->p_acpd.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpd.p_acpt_type = type | (compress ? pflag_compress : 0) | (zstd ? pflag_compress_zstd : 0);
 #ifdef TRUSTED_AUTH
 	send->p_acpd.p_acpt_type |= pflag_win_sspi_nego;
 #endif
@@ -2046,7 +2066,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_acpt.p_acpt_version = port->port_protocol = version;
 	send->p_acpt.p_acpt_architecture = architecture;
-	send->p_acpt.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpt.p_acpt_type = type | (compress ? pflag_compress : 0) | (zstd ? pflag_compress_zstd : 0);
 
 	// modify the version string to reflect the chosen protocol
 	string buffer;
@@ -2240,7 +2260,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_operation = returnData ? op_accept_data : op_accept;
 	if (send->p_acpt.p_acpt_type & pflag_compress)
-		port->initCompression();
+		port->initCompression(send->p_acpt.p_acpt_type & pflag_compress_zstd);
 	port->send(send);
 	if (send->p_acpt.p_acpt_type & pflag_compress)
 		port->port_flags |= PORT_compressed;
@@ -2269,7 +2289,7 @@ void ConnectAuth::accept(PACKET* send, Auth::WriterImplementation*)
 		authPort->extractNewKeys(s);
 		send->p_acpd.p_acpt_authenticated = 1;
 		if (send->p_acpt.p_acpt_type & pflag_compress)
-			authPort->initCompression();
+			authPort->initCompression(send->p_acpt.p_acpt_type & pflag_compress_zstd);
 		authPort->send(send);
 		if (send->p_acpt.p_acpt_type & pflag_compress)
 			authPort->port_flags |= PORT_compressed;
@@ -4206,7 +4226,7 @@ ISC_STATUS rem_port::fetch(P_SQLDATA * sqldata, PACKET* sendL, bool scroll)
 
 	// Check to see if any messages are already sitting around
 
-	const FB_UINT64 org_packets = this->port_snd_packets;
+	const FB_UINT64 org_bytes = this->port_snd_bytes;
 
 	USHORT count = 0;
 	bool success = true;
@@ -4329,11 +4349,10 @@ ISC_STATUS rem_port::fetch(P_SQLDATA * sqldata, PACKET* sendL, bool scroll)
 
 		message->msg_address = NULL;
 
-		// If we've hit maximum prefetch size, break out of loop
+		// If we've filled the fetch window, break out of loop. Up to the
+		// window, rows are streamed to the client as soon as packets fill up.
 
-		const USHORT packets = this->port_snd_packets - org_packets;
-
-		if (packets >= MAX_PACKETS_PER_BATCH && count >= MIN_ROWS_PER_BATCH)
+		if (this->port_snd_bytes - org_bytes >= MAX_FETCH_WINDOW && count >= MIN_ROWS_PER_BATCH)
 			break;
 	}
 
@@ -5357,6 +5376,17 @@ static bool process_packet(rem_port* port, PACKET* sendL, PACKET* receive, rem_p
 			break;
 		}
 
+		// Response kept in the send buffer by send_response() is not followed
+		// by another reply when the request had none, like op_cancel. Flush it
+		// before waiting for more data from the client.
+
+		if (port && port->port_resp_deferred && port->port_state == rem_port::PENDING &&
+			!port->haveRecvData())
+		{
+			sendL->p_operation = op_dummy;
+			port->send(sendL);
+		}
+
 		if (port && port->port_state == rem_port::BROKEN)
 		{
 			if (!port->port_parent)
@@ -6342,10 +6372,19 @@ ISC_STATUS rem_port::send_response(	PACKET*	sendL,
 	response->p_resp_object = object;
 	response->p_resp_data.cstr_length = length;
 
-	const bool defer = (this->port_flags & PORT_lazy) && defer_flag;
+	// If the client has already pipelined more requests, don't flush the
+	// response: it will leave in the same network write as the responses
+	// to those requests. Requests without reply (like op_cancel) make
+	// process_packet() flush it when no request data is left.
+	const bool coalesce = !defer_flag && !exit_code && haveRecvData();
+	const bool defer = (this->port_flags & PORT_lazy) && (defer_flag || coalesce);
 
 	if (defer)
+	{
 		this->send_partial(sendL);
+		if (coalesce)
+			this->port_resp_deferred = true;
+	}
 	else
 	{
 		this->send(sendL);
@@ -6933,6 +6972,7 @@ static THREAD_ENTRY_DECLARE loopThread(THREAD_ENTRY_PARAM)
 			REMOTE_TRACE(("Dequeue request %p", request_que));
 			request_que = request->req_next;
 			ports_pending--;
+			requests_dequeued++;
 			reqQueGuard.leave();
 
 			while (request)
@@ -7079,6 +7119,7 @@ static THREAD_ENTRY_DECLARE loopThread(THREAD_ENTRY_PARAM)
 							request = request_que;
 							request_que = request->req_next;
 							ports_pending--;
+							requests_dequeued++;
 						}
 						else {
 							request = NULL;
@@ -7352,7 +7393,94 @@ bool Worker::wakeUp()
 	if (m_cntAll - m_cntGoing >= ports_active + ports_pending)
 		return true;
 
-	return (m_cntAll - m_cntGoing >= MAX_THREADS);
+	if (m_cntAll - m_cntGoing < maxThreads())
+		return false;
+
+	// When the limit of threads is reached, request stays in the queue
+	// until one of the workers completes its current request
+	limitReached();
+	return true;
+}
+
+void Worker::limitReached()
+{
+/**************************************
+ *
+ *	l i m i t R e a c h e d
+ *
+ **************************************
+ *
+ * Functional description
+ *	All allowed workers are busy and a request is queued.
+ *	Report it once and make sure the queue is watched for stalls.
+ *	Caller holds request_que_mutex and m_mutex.
+ *
+ **************************************/
+	if (!m_limitLogged)
+	{
+		m_limitLogged = true;
+		gds__log("Remote server: all %d worker threads are busy, requests are queued "
+			"(see MaxWorkerThreads in firebird.conf)", maxThreads());
+	}
+
+	if (!m_watching && !isShuttingDown())
+	{
+		try
+		{
+			Thread::start(stallThread, NULL, THREAD_medium, &m_watchHandle);
+			m_watching = true;
+		}
+		catch (const Exception&)
+		{}	// queued requests still wait for a worker to complete
+	}
+}
+
+void Worker::watchStalls()
+{
+/**************************************
+ *
+ *	w a t c h S t a l l s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Workers may all wait for locks held by connections whose
+ *	requests are queued behind them. If no queued request was
+ *	taken for STALL_TIMEOUT seconds, start one more worker over
+ *	the limit. It exits as usual after IDLE_TIMEOUT without work.
+ *
+ **************************************/
+	FB_UINT64 lastDequeued = 0;
+
+	while (!isShuttingDown())
+	{
+		m_watchSem->tryEnter(STALL_TIMEOUT);
+
+		MutexLockGuard reqQueGuard(request_que_mutex, FB_FUNCTION);
+
+		const bool stalled = ports_pending && requests_dequeued == lastDequeued;
+		lastDequeued = requests_dequeued;
+
+		if (!stalled)
+			continue;
+
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+		if (isShuttingDown() || m_idleWorkers)
+			continue;
+
+		if (startThread())
+		{
+			gds__log("Remote server: no queued request was taken by %d busy worker threads "
+				"for %d seconds, started one more", m_cntAll - m_cntGoing - 1, STALL_TIMEOUT);
+		}
+	}
+}
+
+int Worker::maxThreads()
+{
+	static const int limit = Config::getMaxWorkerThreads();
+	return limit > 0 ? limit : MAX_SLONG;
 }
 
 void Worker::wakeUpAll()
@@ -7414,19 +7542,26 @@ void Worker::start(USHORT flags)
 			return;
 
 		MutexLockGuard guard(m_mutex, FB_FUNCTION);
-		try
-		{
-			Thread::start(loopThread, (void*)(IPTR) flags, THREAD_medium);
-			++m_cntAll;
-		}
-		catch (const Exception&)
-		{
-			if (!m_cntAll)
-			{
-				Arg::Gds(isc_no_threads).raise();
-			}
-		}
+		m_flags = flags;
+
+		if (!startThread() && !m_cntAll)
+			Arg::Gds(isc_no_threads).raise();
+	}
+}
+
+bool Worker::startThread()
+{
+	try
+	{
+		Thread::start(loopThread, (void*)(IPTR) m_flags, THREAD_medium);
+		++m_cntAll;
+	}
+	catch (const Exception&)
+	{
+		return false;
 	}
+
+	return true;
 }
 
 void Worker::shutdown()
@@ -7454,6 +7589,29 @@ void Worker::shutdown()
 		}
 		m_mutex->enter(FB_FUNCTION);
 	}
+
+	if (m_watching)
+	{
+		m_watchSem->release();
+		m_mutex->leave();	// stall watcher may wait for it
+		Thread::waitForCompletion(m_watchHandle);
+		m_mutex->enter(FB_FUNCTION);
+		m_watching = false;
+	}
+}
+
+static THREAD_ENTRY_DECLARE stallThread(THREAD_ENTRY_PARAM)
+{
+	try
+	{
+		Worker::watchStalls();
+	}
+	catch (const Exception& ex)
+	{
+		iscLogException("Error while watching the queue of requests", ex);
+	}
+
+	return 0;
 }
 
 static int shut_server(const int, const int, void*)